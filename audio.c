@@ -0,0 +1,247 @@
+//
+//  audio.c
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+#include "audio.h"
+
+#define AUDIO_MIX_FRAMES 512 // taille d'un passage de mixage dans le callback
+
+typedef struct
+{
+    Sint16 *pcm; // entrelacé, AUDIO_CHANNELS canaux
+    uint32_t frames;
+} Sound;
+
+typedef struct
+{
+    int sound; // -1 = voix libre
+    uint32_t pos;
+    int volume;
+    uint32_t seq;        // ordre de déclenchement, pour voler la plus ancienne
+    uint64_t trigger_ns; // 0 une fois la voix mixée (latence déjà comptée)
+} Voice;
+
+static SDL_AudioStream *stream = NULL;
+static Sound sounds[AUDIO_MAX_SOUNDS];
+static int sound_count = 0;
+static Voice voices[AUDIO_MAX_VOICES];
+static uint32_t voice_seq = 0;
+static int buffer_frames = AUDIO_DEFAULT_BUFFER_FRAMES;
+static AudioLatency latency;
+static uint32_t stolen = 0;
+
+static const SDL_AudioSpec mix_spec = {SDL_AUDIO_S16, AUDIO_CHANNELS, AUDIO_FREQ};
+
+void audio_set_buffer_frames(int frames)
+{
+    if (frames > 0)
+        buffer_frames = frames;
+}
+
+int audio_get_buffer_frames(void)
+{
+    return buffer_frames;
+}
+
+// --- THREAD AUDIO ---
+// Appelé par SDL avec le verrou du flux tenu : audio_play prend le même verrou.
+
+static void mix_voices(Sint16 *out, int frames)
+{
+    static Sint32 acc[AUDIO_MIX_FRAMES * AUDIO_CHANNELS];
+    int samples = frames * AUDIO_CHANNELS;
+    memset(acc, 0, (size_t)samples * sizeof(Sint32));
+
+    uint64_t now = SDL_GetTicksNS();
+    for (int v = 0; v < AUDIO_MAX_VOICES; v++)
+    {
+        Voice *voice = &voices[v];
+        if (voice->sound < 0)
+            continue;
+
+        // Premier mixage : ces échantillons sortent après le tampon en cours
+        if (voice->trigger_ns)
+        {
+            audio_latency_add(&latency, now - voice->trigger_ns + (uint64_t)buffer_frames * 1000000000ull / AUDIO_FREQ);
+            voice->trigger_ns = 0;
+        }
+
+        const Sound *s = &sounds[voice->sound];
+        uint32_t n = s->frames - voice->pos;
+        if (n > (uint32_t)frames)
+            n = (uint32_t)frames;
+        const Sint16 *src = s->pcm + (size_t)voice->pos * AUDIO_CHANNELS;
+        for (uint32_t i = 0; i < n * AUDIO_CHANNELS; i++)
+            acc[i] += (src[i] * voice->volume) >> 7;
+
+        voice->pos += n;
+        if (voice->pos >= s->frames)
+            voice->sound = -1;
+    }
+
+    for (int i = 0; i < samples; i++)
+        out[i] = (Sint16)(acc[i] > 32767 ? 32767 : acc[i] < -32768 ? -32768 : acc[i]);
+}
+
+static void audio_callback(void *userdata, SDL_AudioStream *s, int additional_amount, int total_amount)
+{
+    (void)userdata;
+    (void)total_amount;
+    Sint16 out[AUDIO_MIX_FRAMES * AUDIO_CHANNELS];
+    int frame_bytes = (int)sizeof(Sint16) * AUDIO_CHANNELS;
+
+    while (additional_amount > 0)
+    {
+        int frames = (additional_amount + frame_bytes - 1) / frame_bytes;
+        if (frames > AUDIO_MIX_FRAMES)
+            frames = AUDIO_MIX_FRAMES;
+        mix_voices(out, frames);
+        SDL_PutAudioStreamData(s, out, frames * frame_bytes);
+        additional_amount -= frames * frame_bytes;
+    }
+}
+
+// --- INITIALISATION ---
+
+bool audio_init(void)
+{
+    for (int v = 0; v < AUDIO_MAX_VOICES; v++)
+        voices[v].sound = -1;
+    latency = (AudioLatency){0, 0, 0};
+    stolen = 0;
+
+    if (!SDL_InitSubSystem(SDL_INIT_AUDIO))
+    {
+        printf("⚠️ Erreur audio : %s\n", SDL_GetError());
+        return false;
+    }
+
+    // À poser avant l'ouverture du périphérique
+    char frames_hint[16];
+    snprintf(frames_hint, sizeof(frames_hint), "%d", buffer_frames);
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, frames_hint);
+
+    stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &mix_spec, audio_callback, NULL);
+    if (!stream)
+    {
+        printf("⚠️ Erreur audio : %s\n", SDL_GetError());
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return false;
+    }
+
+    // Le périphérique peut refuser la taille demandée : on garde la vraie
+    SDL_AudioSpec device_spec;
+    int device_frames = 0;
+    if (SDL_GetAudioDeviceFormat(SDL_GetAudioStreamDevice(stream), &device_spec, &device_frames) && device_frames > 0)
+        buffer_frames = device_frames;
+
+    SDL_ResumeAudioStreamDevice(stream);
+    printf("🔊 Audio initialisé (mixeur interne, tampon %d échantillons, %.1f ms).\n",
+           buffer_frames, buffer_frames * 1000.0 / AUDIO_FREQ);
+    return true;
+}
+
+void audio_close(void)
+{
+    if (stream)
+    {
+        SDL_DestroyAudioStream(stream); // arrête le thread audio
+        stream = NULL;
+        audio_latency_print("mixeur interne", &latency);
+        if (stolen)
+            printf("🔊 Voix volées : %u\n", stolen);
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    }
+    for (int i = 0; i < sound_count; i++)
+        SDL_free(sounds[i].pcm);
+    sound_count = 0;
+}
+
+int audio_load(const char *path)
+{
+    if (sound_count >= AUDIO_MAX_SOUNDS)
+        return -1;
+
+    SDL_AudioSpec spec;
+    Uint8 *wav = NULL;
+    Uint32 wav_len = 0;
+    if (!SDL_LoadWAV(path, &spec, &wav, &wav_len))
+    {
+        printf("⚠️ Erreur chargement son %s : %s\n", path, SDL_GetError());
+        return -1;
+    }
+
+    // Conversion unique vers le format de mixage : plus rien à faire en jeu
+    Uint8 *pcm = NULL;
+    int pcm_len = 0;
+    bool ok = SDL_ConvertAudioSamples(&spec, wav, (int)wav_len, &mix_spec, &pcm, &pcm_len);
+    SDL_free(wav);
+    if (!ok)
+    {
+        printf("⚠️ Erreur conversion son %s : %s\n", path, SDL_GetError());
+        return -1;
+    }
+
+    sounds[sound_count].pcm = (Sint16 *)pcm;
+    sounds[sound_count].frames = (uint32_t)pcm_len / (sizeof(Sint16) * AUDIO_CHANNELS);
+    return sound_count++;
+}
+
+void audio_play(int sound, int volume)
+{
+    if (!stream || sound < 0 || sound >= sound_count)
+        return;
+
+    SDL_LockAudioStream(stream);
+
+    // Voix libre, sinon la plus ancienne
+    int slot = 0;
+    for (int v = 0; v < AUDIO_MAX_VOICES; v++)
+    {
+        if (voices[v].sound < 0)
+        {
+            slot = v;
+            break;
+        }
+        if (voices[v].seq - voices[slot].seq > UINT32_MAX / 2) // seq plus petit, malgré le rebouclage
+            slot = v;
+    }
+    if (voices[slot].sound >= 0)
+        stolen++;
+
+    voices[slot] = (Voice){sound, 0, volume > AUDIO_VOLUME_MAX ? AUDIO_VOLUME_MAX : volume, voice_seq++, SDL_GetTicksNS()};
+
+    SDL_UnlockAudioStream(stream);
+}
+
+// --- LATENCE ---
+
+void audio_latency_add(AudioLatency *lat, uint64_t ns)
+{
+    lat->count++;
+    lat->sum_ns += ns;
+    if (ns > lat->max_ns)
+        lat->max_ns = ns;
+}
+
+void audio_latency_print(const char *label, const AudioLatency *lat)
+{
+    if (lat->count == 0)
+        return;
+    printf("🔊 Latence son (%s) : moy %.1f ms, max %.1f ms sur %u sons\n", label,
+           lat->sum_ns / 1e6 / lat->count, lat->max_ns / 1e6, lat->count);
+}
+
+AudioLatency audio_get_latency(void)
+{
+    if (!stream)
+        return latency;
+    SDL_LockAudioStream(stream);
+    AudioLatency copy = latency;
+    SDL_UnlockAudioStream(stream);
+    return copy;
+}
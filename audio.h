@@ -0,0 +1,55 @@
+//
+//  audio.h
+//
+//  Moteur de sons en processus, utilisé quand SDL_mixer est absent : les WAV
+//  sont décodés une fois au chargement (cache PCM au format du périphérique),
+//  puis mixés sur le thread audio de SDL dans un flux SDL_AudioStream.
+//  Nombre de voix borné : quand elles sont toutes prises, la plus ancienne
+//  est volée. Aucun processus ni aucune lecture disque pendant la partie.
+//
+//  La latence déclenchement -> sortie est mesurée pour chaque son : temps
+//  entre audio_play et le premier mixage de la voix, plus la durée d'un
+//  tampon du périphérique (ce qui reste à jouer avant nos échantillons).
+//
+
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define AUDIO_MAX_SOUNDS 8
+#define AUDIO_MAX_VOICES 16
+#define AUDIO_FREQ 44100
+#define AUDIO_CHANNELS 2
+#define AUDIO_DEFAULT_BUFFER_FRAMES 256 // ~5.8 ms à 44.1 kHz (SDL_mixer utilisait 2048, ~46 ms)
+#define AUDIO_VOLUME_MAX 128
+
+// Latence mesurée entre le déclenchement d'un son et sa sortie
+typedef struct
+{
+    uint32_t count;
+    uint64_t sum_ns;
+    uint64_t max_ns;
+} AudioLatency;
+
+// Taille du tampon du périphérique en échantillons par canal (avant audio_init).
+// Plus petit = moins de latence, mais plus de réveils du thread audio.
+void audio_set_buffer_frames(int frames);
+int audio_get_buffer_frames(void);
+
+bool audio_init(void);
+void audio_close(void);
+
+// Décode un WAV dans le cache PCM. Renvoie l'identifiant du son, ou -1.
+int audio_load(const char *path);
+
+// Joue un son (volume 0..AUDIO_VOLUME_MAX). Ne bloque que le temps de poser la voix.
+void audio_play(int sound, int volume);
+
+// Latence déclenchement -> sortie
+void audio_latency_add(AudioLatency *lat, uint64_t ns);
+void audio_latency_print(const char *label, const AudioLatency *lat);
+AudioLatency audio_get_latency(void);
+
+#endif // AUDIO_H
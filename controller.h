@@ -2,6 +2,9 @@
 #ifndef CONTROLLER_H
 #define CONTROLLER_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 // commandes abstraites (independantes du clavier)
 typedef enum {
     CMD_NONE,
@@ -24,4 +27,36 @@ typedef enum {
     BTN_DOWN
 } KEY_BOUTONS;
 
+// Boutons tenus : un bit par KEY_BOUTONS, on peut se déplacer et tirer
+// pendant le même tick
+typedef uint16_t ButtonMask;
+#define BTN_MASK(btn) ((ButtonMask)(1u << (btn)))
+#define BTN_GAMEPLAY_MASK (BTN_MASK(BTN_LEFT) | BTN_MASK(BTN_RIGHT) | BTN_MASK(BTN_UP) | BTN_MASK(BTN_DOWN) | BTN_MASK(BTN_FIRE))
+
+#define INPUT_MAX_PRESSES 16
+
+// Relevé des entrées d'une image : tout ce qui est en attente est lu d'un
+// coup par GameView.get_input
+typedef struct
+{
+    ButtonMask held;                        // boutons enfoncés (un appui déjà relâché compte pour cette image)
+    int count;                              // appuis depuis le relevé précédent
+    KEY_BOUTONS presses[INPUT_MAX_PRESSES]; // dans l'ordre d'arrivée (menus, pause, quitter)
+} InputState;
+
+static inline void input_press(InputState *in, KEY_BOUTONS btn)
+{
+    in->held |= BTN_MASK(btn);
+    if (in->count < INPUT_MAX_PRESSES)
+        in->presses[in->count++] = btn;
+}
+
+static inline bool input_pressed(const InputState *in, KEY_BOUTONS btn)
+{
+    for (int i = 0; i < in->count; i++)
+        if (in->presses[i] == btn)
+            return true;
+    return false;
+}
+
 #endif // CONTROLLER_H
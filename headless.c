@@ -0,0 +1,276 @@
+//
+//  headless.c
+//
+//  Simulation sans affichage : fait tourner model_step à pleine vitesse (pas
+//  de vue, pas de sommeil) avec des entrées scriptées, puis affiche le débit.
+//  Ne dépend que de model.c : sert à mesurer le coût pur de la simulation.
+//
+//  Usage : space-invaders-headless [--ticks=N] [--seed=N] [--record=F | --replay=F] [--rewind] [--trace=F]
+//
+//  --record=F enregistre la première partie (entrées scriptées) dans F ;
+//  --replay=F rejoue F (graine et entrées du fichier) et vérifie que le score
+//  final est identique à celui enregistré.
+//  --rewind garde un snapshot par tick (comme le jeu) puis vérifie qu'un
+//  rembobinage d'une seconde suivi d'une resimulation retombe sur le même état.
+//  --trace=F écrit dans F les sections de model_step (format trace Chrome).
+//
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include "view.h"
+#include "replay.h"
+#include "snapshot.h"
+#include "trace.h"
+
+#define DEFAULT_TICKS 1000000L
+
+// --- VUE NULLE ---
+// Même interface que les vraies vues, mais rien n'est affiché ni lu.
+
+static void null_init(void) {}
+static void null_close(void) {}
+static void null_render(const GameModel *model) { (void)model; }
+static void null_get_input(InputState *input) { *input = (InputState){0}; }
+static void null_handle_events(const ModelEvent *events, int count)
+{
+    (void)events;
+    (void)count;
+}
+
+static GameView null_view(void)
+{
+    GameView v;
+    v.init = null_init;
+    v.close = null_close;
+    v.render = null_render;
+    v.get_input = null_get_input;
+    v.handle_events = null_handle_events;
+    return v;
+}
+
+// --- ENTRÉES SCRIPTÉES ---
+// Balayage gauche / droite par blocs de 40 ticks, un tir tous les 4 ticks
+// (sur place : mêmes parties qu'avant le masque de boutons).
+static ButtonMask scripted_input(long tick)
+{
+    if (tick % 4 == 0)
+        return BTN_MASK(BTN_FIRE);
+    switch ((tick / 40) % 3)
+    {
+    case 0:
+        return BTN_MASK(BTN_LEFT);
+    case 1:
+        return BTN_MASK(BTN_RIGHT);
+    default:
+        return 0;
+    }
+}
+
+// --- POOLS PLEINS ---
+// Spawns refusés ou slots recyclés selon la politique de chaque pool,
+// cumulés sur toutes les parties (model_init remet les compteurs à zéro).
+#define POOL_STATS 3
+
+static void add_pool_stats(const GameModel *game, uint64_t full[POOL_STATS])
+{
+    const SlotPool *pools[POOL_STATS] = {&game->bullets.slots, &game->explosions.slots, &game->items.slots};
+    for (int i = 0; i < POOL_STATS; i++)
+        full[i] += pools[i]->policy == POOL_FULL_REJECT ? pools[i]->rejected : pools[i]->evicted;
+}
+
+static void print_pool_stats(const GameModel *game, const uint64_t full[POOL_STATS])
+{
+    static const char *names[POOL_STATS] = {"balles", "explosions", "items"};
+    static const bool feminine[POOL_STATS] = {true, true, false};
+    const SlotPool *pools[POOL_STATS] = {&game->bullets.slots, &game->explosions.slots, &game->items.slots};
+    printf("Pools pleins  :");
+    for (int i = 0; i < POOL_STATS; i++)
+        printf("%s %s %llu %s%s", i ? "," : "", names[i], (unsigned long long)full[i],
+               pools[i]->policy == POOL_FULL_REJECT ? "refusé" : "recyclé", feminine[i] ? "es" : "s");
+    printf("\n");
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    long ticks = DEFAULT_TICKS;
+    uint64_t seed = 1;
+    const char *record_path = NULL;
+    const char *replay_path = NULL;
+    bool rewind_check = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strncmp(argv[i], "--ticks=", 8) == 0)
+            ticks = atol(argv[i] + 8);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            seed = strtoull(argv[i] + 7, NULL, 10);
+        else if (strncmp(argv[i], "--record=", 9) == 0)
+            record_path = argv[i] + 9;
+        else if (strncmp(argv[i], "--replay=", 9) == 0)
+            replay_path = argv[i] + 9;
+        else if (strcmp(argv[i], "--rewind") == 0)
+            rewind_check = true;
+        else if (strncmp(argv[i], "--trace=", 8) == 0)
+        {
+            if (!trace_init(argv[i] + 8))
+                return 1;
+        }
+        else
+        {
+            fprintf(stderr, "Usage : %s [--ticks=N] [--seed=N] [--record=F | --replay=F] [--rewind] [--trace=F]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (rewind_check && replay_path)
+    {
+        fprintf(stderr, "--rewind resimule avec les entrées scriptées : incompatible avec --replay.\n");
+        return 1;
+    }
+
+    Replay replay = {0};
+    if (replay_path)
+    {
+        if (!replay_load(&replay, replay_path))
+            return 1;
+        seed = replay.seed;
+        ticks = (long)replay.ticks;
+    }
+    Replay recording = {0};
+    bool recording_active = (record_path != NULL);
+    if (recording_active)
+        replay_begin_recording(&recording, seed);
+
+    RewindBuffer rewind = {0};
+    if (rewind_check && !rewind_init(&rewind, 1))
+        return 1;
+
+    GameView view = null_view();
+    GameModel game;
+    game.high_score = 0;
+    model_init(&game, seed);
+    view.init();
+    rewind_push(&rewind, &game);
+
+
+    long games = 1;
+    uint64_t events = 0;
+    ModelEvent ev;
+    CollisionStats coll = {0, 0, 0};
+    uint64_t pool_full[POOL_STATS] = {0};
+    double t_start = now_seconds();
+    for (long t = 0; t < ticks; t++)
+    {
+        ButtonMask input = scripted_input(t);
+        if (replay_path && !replay_next(&replay, &input))
+        {
+            ticks = t;
+            break;
+        }
+        model_step(&game, input);
+        rewind_push(&rewind, &game);
+        if (recording_active)
+            replay_record(&recording, input);
+        view.render(&game);
+        while (model_poll_event(&game, &ev))
+            events++;
+        if (game.game_over)
+        {
+            // Un replay couvre une seule partie
+            if (replay_path)
+            {
+                ticks = t + 1;
+                break;
+            }
+            if (recording_active)
+            {
+                replay_save(&recording, record_path, game.score);
+                recording_active = false;
+            }
+            coll.brute_force_pairs += game.collision_stats.brute_force_pairs;
+            coll.candidate_pairs += game.collision_stats.candidate_pairs;
+            coll.confirmed_hits += game.collision_stats.confirmed_hits;
+            add_pool_stats(&game, pool_full);
+            int best = game.high_score;
+            model_init(&game, seed + (uint64_t)games); // partie suivante : graine dérivée, toujours reproductible
+            game.high_score = best;
+            games++;
+            rewind_clear(&rewind);
+            rewind_push(&rewind, &game);
+        }
+    }
+    double wall = now_seconds() - t_start;
+    coll.brute_force_pairs += game.collision_stats.brute_force_pairs;
+    coll.candidate_pairs += game.collision_stats.candidate_pairs;
+    coll.confirmed_hits += game.collision_stats.confirmed_hits;
+    add_pool_stats(&game, pool_full);
+
+    if (recording_active)
+        replay_save(&recording, record_path, game.score);
+
+    view.close();
+
+    printf("Ticks simulés : %ld (%d Hz, %.1f s de jeu)\n", ticks, MODEL_TICK_HZ, (double)ticks / MODEL_TICK_HZ);
+    printf("Temps réel    : %.3f s\n", wall);
+    printf("Débit         : %.0f ticks/s (%.1f ns/tick, x%.0f temps réel)\n",
+           wall > 0 ? ticks / wall : 0.0, wall > 0 ? wall * 1e9 / ticks : 0.0,
+           wall > 0 ? (double)ticks / MODEL_TICK_HZ / wall : 0.0);
+    printf("Parties       : %ld (graine %llu)\n", games, (unsigned long long)seed);
+    printf("Score final   : %d (level %d), meilleur : %d\n", game.score, game.level,
+           game.score > game.high_score ? game.score : game.high_score);
+    printf("Collisions    : %llu tests (force brute : %llu), %llu touches\n",
+           (unsigned long long)coll.candidate_pairs, (unsigned long long)coll.brute_force_pairs,
+           (unsigned long long)coll.confirmed_hits);
+    printf("Événements    : %llu (vue nulle)\n", (unsigned long long)events);
+    print_pool_stats(&game, pool_full);
+
+    int status = 0;
+    if (rewind_check)
+    {
+        // Recul d'une seconde puis resimulation avec les mêmes entrées :
+        // on doit retrouver l'état final à l'octet près
+        Snapshot now;
+        snapshot_save(&game, &now);
+        int back = rewind_step(&rewind, &game, MODEL_TICK_HZ);
+        for (int i = back; i > 0; i--)
+            model_step(&game, scripted_input(ticks - i));
+        Snapshot again;
+        snapshot_save(&game, &again);
+        bool same = memcmp(now.bytes, again.bytes, SNAPSHOT_SIZE) == 0;
+
+        // Coût d'un snapshot, mesuré à part pour ne pas le noyer dans le tick
+        int reps = 100000;
+        double t0 = now_seconds();
+        for (int i = 0; i < reps; i++)
+            rewind_push(&rewind, &game);
+        double snap_ns = (now_seconds() - t0) * 1e9 / reps;
+
+        printf("Rembobinage   : %d ticks rejoués -> %s (%zu octets/snapshot, %.0f ns/snapshot)\n", back,
+               same ? "identique" : "DIVERGENCE", (size_t)SNAPSHOT_SIZE, snap_ns);
+        if (!same)
+            status = 1;
+    }
+    if (replay_path)
+    {
+        bool same = (game.score == replay.final_score);
+        printf("Replay        : score %d, enregistré %d -> %s\n", game.score, replay.final_score,
+               same ? "identique" : "DIVERGENCE");
+        status = same ? 0 : 1;
+    }
+    replay_free(&replay);
+    replay_free(&recording);
+    rewind_free(&rewind);
+    return status;
+}
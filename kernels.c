@@ -0,0 +1,84 @@
+//
+//  kernels.c
+//
+
+#include <string.h>
+#include "kernels.h"
+#include "pool.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define KERNEL_LANES 8
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define KERNEL_LANES 4
+#else
+#define KERNEL_LANES 1
+#endif
+
+// --- RÉFÉRENCES SCALAIRES ---
+
+void kernel_integrate_y_scalar(float *y, const float *dy, int n, float dt, float lo, float hi, uint64_t *retire)
+{
+    memset(retire, 0, POOL_WORDS(n) * sizeof(uint64_t));
+    for (int i = 0; i < n; i++)
+    {
+        y[i] += dy[i] * dt;
+        retire[i >> 6] |= (uint64_t)(y[i] < lo || y[i] > hi) << (i & 63);
+    }
+}
+
+#if KERNEL_LANES > 1
+
+// Les blocs de KERNEL_LANES ne chevauchent jamais deux mots de 64 bits
+// (64 est multiple de 4 et de 8) : chaque movemask s'insère d'un seul OR.
+
+void kernel_integrate_y(float *y, const float *dy, int n, float dt, float lo, float hi, uint64_t *retire)
+{
+    memset(retire, 0, POOL_WORDS(n) * sizeof(uint64_t));
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256 vdt = _mm256_set1_ps(dt), vlo = _mm256_set1_ps(lo), vhi = _mm256_set1_ps(hi);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 v = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(dy + i), vdt));
+        _mm256_storeu_ps(y + i, v);
+        __m256 out = _mm256_or_ps(_mm256_cmp_ps(v, vlo, _CMP_LT_OQ), _mm256_cmp_ps(v, vhi, _CMP_GT_OQ));
+        retire[i >> 6] |= (uint64_t)_mm256_movemask_ps(out) << (i & 63);
+    }
+#else
+    const __m128 vdt = _mm_set1_ps(dt), vlo = _mm_set1_ps(lo), vhi = _mm_set1_ps(hi);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 v = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(dy + i), vdt));
+        _mm_storeu_ps(y + i, v);
+        __m128 out = _mm_or_ps(_mm_cmplt_ps(v, vlo), _mm_cmpgt_ps(v, vhi));
+        retire[i >> 6] |= (uint64_t)_mm_movemask_ps(out) << (i & 63);
+    }
+#endif
+    for (; i < n; i++)
+    {
+        y[i] += dy[i] * dt;
+        retire[i >> 6] |= (uint64_t)(y[i] < lo || y[i] > hi) << (i & 63);
+    }
+}
+
+#else // Pas de SIMD : les kernels sont les références scalaires
+
+void kernel_integrate_y(float *y, const float *dy, int n, float dt, float lo, float hi, uint64_t *retire)
+{
+    kernel_integrate_y_scalar(y, dy, n, dt, lo, hi, retire);
+}
+
+#endif
+
+const char *kernel_isa(void)
+{
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalaire";
+#endif
+}
@@ -0,0 +1,31 @@
+//
+//  kernels.h
+//
+//  Passes d'intégration des pools (balles, items) traitées par
+//  lots : tous les slots du pool sont mis à jour d'un coup, sans branche, et
+//  les slots à libérer sortent sous forme de masque de bits (même format que
+//  SlotPool.live), appliqué ensuite par slot_release_mask.
+//
+//  Version AVX2 (8 floats), SSE2 (4 floats) ou scalaire, choisie à la
+//  compilation (-mavx2 active __AVX2__ ; SSE2 est toujours présent en x86-64).
+//  Les trois versions donnent des résultats identiques au bit près : même
+//  opération y + dy * dt (multiplication puis addition, pas de FMA), mêmes
+//  comparaisons.
+//
+
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <stdint.h>
+
+// y[i] += dy[i] * dt ; bit i de retire = (y[i] < lo || y[i] > hi).
+// retire doit contenir POOL_WORDS(n) mots ; les bits au-delà de n sont à zéro.
+void kernel_integrate_y(float *y, const float *dy, int n, float dt, float lo, float hi, uint64_t *retire);
+
+// Références scalaires (toujours compilées, pour le micro-benchmark et la vérification)
+void kernel_integrate_y_scalar(float *y, const float *dy, int n, float dt, float lo, float hi, uint64_t *retire);
+
+// "avx2", "sse2" ou "scalaire"
+const char *kernel_isa(void);
+
+#endif // KERNELS_H
@@ -0,0 +1,200 @@
+//
+//  kernels_bench.c
+//
+//  Micro-benchmark des kernels d'intégration (kernels.c) : compare la boucle
+//  slot par slot d'origine, la version par lots scalaire et la version SIMD,
+//  à la taille actuelle des pools puis x10 et x100. Vérifie au passage que
+//  scalaire et SIMD donnent les mêmes résultats au bit près.
+//
+//  Usage : space-invaders-bench [--reps=N]
+//
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include "kernels.h"
+#include "model.h"
+
+#define DEFAULT_REPS 200000L
+
+typedef enum
+{
+    PASS_BULLETS,
+    PASS_ITEMS
+} PassKind;
+
+typedef struct
+{
+    int n;
+    float *y, *dy;
+    uint64_t *live, *live0, *retire;
+} Lanes;
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Même remplissage que pendant une partie : environ un slot sur deux vivant
+static void lanes_fill(Lanes *l, int n, uint64_t seed)
+{
+    Rng rng;
+    rng_seed(&rng, seed, 0);
+    int words = POOL_WORDS(n);
+    l->n = n;
+    l->y = malloc((size_t)n * sizeof(float));
+    l->dy = malloc((size_t)n * sizeof(float));
+    l->live = calloc((size_t)words, sizeof(uint64_t));
+    l->live0 = calloc((size_t)words, sizeof(uint64_t));
+    l->retire = calloc((size_t)words, sizeof(uint64_t));
+    for (int i = 0; i < n; i++)
+    {
+        l->y[i] = rng_float(&rng) * GAME_HEIGHT;
+        l->dy[i] = (rng_float(&rng) - 0.5f) * 1000.0f;
+        if (rng_range(&rng, 2))
+            pool_set(l->live0, i);
+    }
+    memcpy(l->live, l->live0, (size_t)words * sizeof(uint64_t));
+}
+
+static void lanes_free(Lanes *l)
+{
+    free(l->y);
+    free(l->dy);
+    free(l->live);
+    free(l->live0);
+    free(l->retire);
+}
+
+static float pass_lo(PassKind kind)
+{
+    return kind == PASS_BULLETS ? 0.0f : -INFINITY;
+}
+
+// Boucle d'origine de model_update : slot vivant par slot vivant, avec branche
+static void pass_loop(Lanes *l, PassKind kind, float dt)
+{
+    float lo = pass_lo(kind);
+    for (int w = 0; w < POOL_WORDS(l->n); w++)
+    {
+        for (uint64_t bits = l->live[w]; bits; bits &= bits - 1)
+        {
+            int i = (w << 6) + __builtin_ctzll(bits);
+            l->y[i] += l->dy[i] * dt;
+            if (l->y[i] < lo || l->y[i] > GAME_HEIGHT)
+                pool_clear(l->live, i);
+        }
+    }
+}
+
+static void release(Lanes *l)
+{
+    for (int w = 0; w < POOL_WORDS(l->n); w++)
+        l->live[w] &= ~l->retire[w];
+}
+
+static void pass_scalar(Lanes *l, PassKind kind, float dt)
+{
+    kernel_integrate_y_scalar(l->y, l->dy, l->n, dt, pass_lo(kind), GAME_HEIGHT, l->retire);
+    release(l);
+}
+
+static void pass_simd(Lanes *l, PassKind kind, float dt)
+{
+    kernel_integrate_y(l->y, l->dy, l->n, dt, pass_lo(kind), GAME_HEIGHT, l->retire);
+    release(l);
+}
+
+typedef void (*PassFn)(Lanes *l, PassKind kind, float dt);
+
+// ns par passe. Le pas alterne de signe pour que les valeurs restent dans
+// la même plage, et le masque live est restauré à chaque passe.
+static double time_pass(PassFn fn, PassKind kind, int n, long reps)
+{
+    Lanes l;
+    lanes_fill(&l, n, 42);
+    size_t live_bytes = (size_t)POOL_WORDS(n) * sizeof(uint64_t);
+    double t0 = now_seconds();
+    for (long r = 0; r < reps; r++)
+    {
+        memcpy(l.live, l.live0, live_bytes);
+        fn(&l, kind, (r & 1) ? -MODEL_TICK_DT : MODEL_TICK_DT);
+    }
+    double ns = (now_seconds() - t0) * 1e9 / (double)reps;
+    lanes_free(&l);
+    return ns;
+}
+
+// Scalaire et SIMD sur les mêmes données pendant 2 * MODEL_TICK_HZ passes
+static bool same_results(PassKind kind, int n)
+{
+    Lanes a, b;
+    lanes_fill(&a, n, 7);
+    lanes_fill(&b, n, 7);
+    bool same = true;
+    for (int r = 0; r < 2 * MODEL_TICK_HZ && same; r++)
+    {
+        pass_scalar(&a, kind, MODEL_TICK_DT);
+        pass_simd(&b, kind, MODEL_TICK_DT);
+        same = memcmp(a.y, b.y, (size_t)n * sizeof(float)) == 0 &&
+               memcmp(a.retire, b.retire, (size_t)POOL_WORDS(n) * sizeof(uint64_t)) == 0;
+    }
+    lanes_free(&a);
+    lanes_free(&b);
+    return same;
+}
+
+int main(int argc, char *argv[])
+{
+    long reps = DEFAULT_REPS;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strncmp(argv[i], "--reps=", 7) == 0)
+            reps = atol(argv[i] + 7);
+        else
+        {
+            fprintf(stderr, "Usage : %s [--reps=N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const struct
+    {
+        const char *name;
+        PassKind kind;
+        int size;
+    } passes[] = {
+        {"balles", PASS_BULLETS, MAX_BULLETS},
+        {"items", PASS_ITEMS, ITEMS_MAX},
+    };
+    const int scales[] = {1, 10, 100};
+
+    printf("Kernels : %s\n", kernel_isa());
+    printf("%-11s %7s %12s %12s %12s %8s %s\n", "pass", "slots", "boucle ns", "scalaire ns", "simd ns", "gain", "identique");
+
+    int status = 0;
+    for (size_t p = 0; p < sizeof(passes) / sizeof(passes[0]); p++)
+    {
+        for (size_t s = 0; s < sizeof(scales) / sizeof(scales[0]); s++)
+        {
+            int n = passes[p].size * scales[s];
+            long r = reps / scales[s];
+            double loop = time_pass(pass_loop, passes[p].kind, n, r);
+            double scalar = time_pass(pass_scalar, passes[p].kind, n, r);
+            double simd = time_pass(pass_simd, passes[p].kind, n, r);
+            bool same = same_results(passes[p].kind, n);
+            if (!same)
+                status = 1;
+            printf("%-11s %7d %12.1f %12.1f %12.1f %7.1fx %s\n", passes[p].name, n, loop, scalar, simd,
+                   simd > 0 ? loop / simd : 0.0, same ? "oui" : "NON");
+        }
+    }
+    return status;
+}
@@ -9,6 +9,16 @@
 #include <SDL3/SDL.h> // Nécessaire pour le launcher SDL3
 #include "view.h"
 #include "controller.h"
+#include "rng.h"
+#include "replay.h"
+#include "snapshot.h"
+#include "audio.h"
+#include "starfield.h"
+#include "perf.h"
+#include "trace.h"
+
+#define REWIND_SECONDS 5                       // historique gardé pour le rembobinage en pause
+#define REWIND_STEP_TICKS (MODEL_TICK_HZ / 60) // un appui sur Gauche/Droite = une image à 60 FPS
 
 // ==========================================
 // --- GESTION DU HIGHSCORE (JSON) ---
@@ -60,13 +70,48 @@ int load_high_score()
     return score;
 }
 
+// Graine d'une nouvelle partie (horloge en nanosecondes)
+static uint64_t make_seed(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Vide la file d'événements du modèle (une fois par image) : messages console
+// ici, sons et effets dans la vue
+static void dispatch_model_events(GameModel *game, const GameView *view)
+{
+    ModelEvent events[MODEL_EVENT_CAPACITY];
+    int count = 0;
+    while (count < MODEL_EVENT_CAPACITY && model_poll_event(game, &events[count]))
+    {
+        const ModelEvent *ev = &events[count++];
+        if (ev->type == MODEL_EVENT_LEVEL_UP)
+        {
+            if (ev->arg % 3 == 0)
+                printf("➡️ Niveau %d : BOSS BATTLE !\n", (int)ev->arg);
+            else
+                printf("➡️ Niveau suivant ! Level %d\n", (int)ev->arg);
+        }
+        else if (ev->type == MODEL_EVENT_BOSS_PHASE)
+        {
+            if (ev->arg == BOSS_APPROACH)
+                printf("⚠️ ALERTE : BOSS ARRIVE ! (HP: %d)\n", game->boss.hp);
+            else
+                printf("⚠️ BOSS ACTIVÉ ! MODE COMBAT ENGAGÉ !\n");
+        }
+    }
+    view->handle_events(events, count);
+}
+
 // ==========================================
 // --- STARTUP LAUNCHER (Menu de choix) ---
 // ==========================================
 
 #define LAUNCHER_WIDTH 800
 #define LAUNCHER_HEIGHT 600
-#define NUM_STARS 150
+#define NUM_STARS 600
 
 typedef enum
 {
@@ -75,14 +120,6 @@ typedef enum
     STARTUP_CHOICE_EXIT
 } StartupResult;
 
-// Structure pour le fond étoilé
-typedef struct
-{
-    float x, y;
-    float speed;
-    uint8_t brightness;
-} Star;
-
 typedef struct
 {
     SDL_FRect rect;
@@ -172,15 +209,10 @@ StartupResult run_startup_menu(void)
     if (!renderer)
         renderer = SDL_CreateRenderer(window, NULL);
 
-    // --- Initialisation des étoiles ---
-    Star stars[NUM_STARS];
-    for (int i = 0; i < NUM_STARS; i++)
-    {
-        stars[i].x = (float)(rand() % LAUNCHER_WIDTH);
-        stars[i].y = (float)(rand() % LAUNCHER_HEIGHT);
-        stars[i].speed = 0.5f + ((float)(rand() % 10) / 10.0f) * 2.0f;
-        stars[i].brightness = 100 + (rand() % 155);
-    }
+    // --- Initialisation des étoiles (flux aléatoire propre au launcher) ---
+    Starfield stars;
+    starfield_init(&stars, NUM_STARS, LAUNCHER_WIDTH, LAUNCHER_HEIGHT, make_seed(), RNG_STREAM_LAUNCHER);
+    uint64_t last_ns = SDL_GetTicksNS();
 
     // --- Définition des boutons (Labels simplifiés pour le rendu pixel) ---
     // SDL : Cyan Néon
@@ -235,16 +267,10 @@ StartupResult run_startup_menu(void)
 
         // --- Mise à jour ---
 
-        // 1. Etoiles
-        for (int i = 0; i < NUM_STARS; i++)
-        {
-            stars[i].y += stars[i].speed;
-            if (stars[i].y > LAUNCHER_HEIGHT)
-            {
-                stars[i].y = 0;
-                stars[i].x = (float)(rand() % LAUNCHER_WIDTH);
-            }
-        }
+        // 1. Etoiles (au temps écoulé, pas au nombre d'images)
+        uint64_t now_ns = SDL_GetTicksNS();
+        starfield_update(&stars, (float)(now_ns - last_ns) / 1e9f);
+        last_ns = now_ns;
 
         // 2. Hover
         btn_sdl.is_hovered = (mouse_x >= btn_sdl.rect.x && mouse_x <= btn_sdl.rect.x + btn_sdl.rect.w &&
@@ -258,11 +284,7 @@ StartupResult run_startup_menu(void)
         SDL_RenderClear(renderer);
 
         // 1. Dessiner les étoiles
-        for (int i = 0; i < NUM_STARS; i++)
-        {
-            SDL_SetRenderDrawColor(renderer, stars[i].brightness, stars[i].brightness, stars[i].brightness, 255);
-            SDL_RenderPoint(renderer, stars[i].x, stars[i].y);
-        }
+        starfield_draw(&stars, renderer);
 
         // 2. TITRE DU JEU (Style Star Wars)
         const char *title = "STAR LAUNCHER";
@@ -289,6 +311,7 @@ StartupResult run_startup_menu(void)
         SDL_Delay(16);
     }
 
+    starfield_free(&stars);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
@@ -302,9 +325,6 @@ StartupResult run_startup_menu(void)
 
 int main(int argc, char *argv[])
 {
-    // Initialisation du générateur de nombres aléatoires
-    srand(time(NULL));
-
     // A. Vérification des arguments (Mode CLI forcé ?)
     int cli_forced_mode = -1; // -1: Pas d'argument, 0: Ncurses, 1: SDL
     for (int i = 1; i < argc; ++i)
@@ -321,6 +341,39 @@ int main(int argc, char *argv[])
         }
     }
 
+    // Enregistrement / relecture des entrées (--record=fichier, --replay=fichier)
+    // taille du tampon audio (--audio-buffer=échantillons), trace des phases (--trace=fichier.json)
+    // débit du terminal en ncurses (--bandwidth=octets/s, pour le SSH lent)
+    const char *record_path = NULL;
+    const char *replay_path = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strncmp(argv[i], "--record=", 9) == 0)
+            record_path = argv[i] + 9;
+        else if (strncmp(argv[i], "--replay=", 9) == 0)
+            replay_path = argv[i] + 9;
+        else if (strncmp(argv[i], "--audio-buffer=", 15) == 0)
+            audio_set_buffer_frames(atoi(argv[i] + 15));
+        else if (strncmp(argv[i], "--trace=", 8) == 0)
+            trace_init(argv[i] + 8); // écrite à la sortie du programme
+        else if (strncmp(argv[i], "--bandwidth=", 12) == 0)
+            view_ncurses_set_bandwidth(atol(argv[i] + 12));
+    }
+
+    Replay replay = {0};
+    Replay recording = {0};
+    bool replaying = false;
+    if (replay_path)
+    {
+        if (!replay_load(&replay, replay_path))
+            return 1;
+        replaying = true;
+    }
+
+    // Historique de rembobinage : alloué une fois pour toute l'application
+    RewindBuffer rewind;
+    rewind_init(&rewind, REWIND_SECONDS);
+
     bool app_running = true;
 
     // CHARGEMENT DU HIGH SCORE DEPUIS LE JSON
@@ -356,7 +409,9 @@ int main(int argc, char *argv[])
         // C. Initialisation du Jeu (Modèle & Vue) pour cette session
         GameModel game;
         game.high_score = saved_high_score; // Restaure le high score dans le jeu
-        model_init(&game);
+        model_init(&game, replaying ? replay.seed : make_seed());
+        if (replaying)
+            replay_rewind(&replay);
 
         // Sécurité : Si model_init réinitialise à 0 alors qu'on avait une save, on restaure
         if (game.high_score == 0 && saved_high_score > 0)
@@ -388,38 +443,44 @@ int main(int argc, char *argv[])
         {
             view.render(&game);
 
-            KEY_BOUTONS m = view.get_input();
-            if (m == BTN_QUIT)
-            {
-                session_running = false; // Retour Launcher
-            }
-            else if (m == BTN_UP)
-            {
-                if (game.menu_selection > 0)
-                    game.menu_selection--;
-            }
-            else if (m == BTN_DOWN)
+            // Appuis dans l'ordre, jusqu'à ce que l'un d'eux quitte le menu
+            InputState menu_input;
+            view.get_input(&menu_input);
+            for (int i = 0; i < menu_input.count && session_running && game.menu_mode == 1; i++)
             {
-                game.menu_selection++;
-                if (game.menu_selection > 3)
-                    game.menu_selection = 3;
-            }
-            else if (m == BTN_SELECT)
-            {
-                switch (game.menu_selection)
+                KEY_BOUTONS m = menu_input.presses[i];
+                if (m == BTN_QUIT)
                 {
-                case 0:                 // Start
-                    game.menu_mode = 0; // Sort de la boucle menu, entre en jeu
-                    break;
-                case 1: // Settings
-                    game.menu_mode = 2;
-                    break;
-                case 2: // High Scores
-                    game.menu_mode = 3;
-                    break;
-                case 3:                      // Quit
                     session_running = false; // Retour Launcher
-                    break;
+                }
+                else if (m == BTN_UP)
+                {
+                    if (game.menu_selection > 0)
+                        game.menu_selection--;
+                }
+                else if (m == BTN_DOWN)
+                {
+                    game.menu_selection++;
+                    if (game.menu_selection > 3)
+                        game.menu_selection = 3;
+                }
+                else if (m == BTN_SELECT)
+                {
+                    switch (game.menu_selection)
+                    {
+                    case 0:                 // Start
+                        game.menu_mode = 0; // Sort de la boucle menu, entre en jeu
+                        break;
+                    case 1: // Settings
+                        game.menu_mode = 2;
+                        break;
+                    case 2: // High Scores
+                        game.menu_mode = 3;
+                        break;
+                    case 3:                      // Quit
+                        session_running = false; // Retour Launcher
+                        break;
+                    }
                 }
             }
 
@@ -427,10 +488,11 @@ int main(int argc, char *argv[])
             while (game.menu_mode == 2 || game.menu_mode == 3)
             {
                 view.render(&game);
-                KEY_BOUTONS sub = view.get_input();
+                InputState sub;
+                view.get_input(&sub);
 
                 // IMPORTANT: Utiliser ESC (BTN_QUIT) pour revenir, pas ENTER
-                if (sub == BTN_QUIT || sub == BTN_FIRE)
+                if (input_pressed(&sub, BTN_QUIT) || input_pressed(&sub, BTN_FIRE))
                 {
                     game.menu_mode = 1; // Retour au menu principal
                 }
@@ -446,30 +508,52 @@ int main(int argc, char *argv[])
         // On n'entre ici que si on a quitté le menu par "Start" (menu_mode == 0)
         int game_loop_running = (session_running && game.menu_mode == 0) ? 1 : 0;
 
-        // Gestion du temps
+        // Gestion du temps : la simulation avance par ticks fixes (MODEL_TICK_DT),
+        // l'affichage interpole entre les deux derniers états
         const int64_t FRAME_NANOS = 16666667LL; // ~60 FPS
+        const int64_t TICK_NANOS = 1000000000LL / MODEL_TICK_HZ;
         struct timespec t_last, t_now, t_after;
         clock_gettime(CLOCK_MONOTONIC, &t_last);
-        float fire_timer = 0.0f;
+        int64_t accumulator_ns = 0;
+        int pending_fires = 0; // appuis de tir pas encore joués : un tir par appui
+        GameModel prev_state = game;  // état au tick précédent
+        GameModel render_state;       // état interpolé envoyé à la vue
+
+        bool recording_active = (game_loop_running && record_path != NULL);
+        if (recording_active)
+            replay_begin_recording(&recording, game.seed);
 
+        rewind_clear(&rewind);
+        rewind_push(&rewind, &game);
+
+        PERF_FRAME_SKIP();
         while (game_loop_running)
         {
+            PERF_FRAME_END();
+
             // Delta Time
             clock_gettime(CLOCK_MONOTONIC, &t_now);
             int64_t delta_ns = (t_now.tv_sec - t_last.tv_sec) * 1000000000LL + (t_now.tv_nsec - t_last.tv_nsec);
-            float delta_s = (float)delta_ns / 1e9f;
-            if (delta_s <= 0.0f)
-                delta_s = 0.001f;
-            if (delta_s > 0.1f)
-                delta_s = 0.1f;
-
-            if (fire_timer > 0.0f)
-                fire_timer -= delta_s;
+            if (delta_ns < 0)
+                delta_ns = 0;
+            accumulator_ns += delta_ns;
+            t_last = t_now;
 
             // Inputs
-            KEY_BOUTONS input = view.get_input();
-
-            switch (input)
+            TRACE_BEGIN("input");
+            PERF_BEGIN(PERF_INPUT);
+            InputState input;
+            view.get_input(&input);
+            PERF_END(PERF_INPUT);
+            TRACE_END("input");
+
+            // Pause et Quitter réagissent à l'appui ; le reste est tenu
+            KEY_BOUTONS action = BTN_NONE;
+            for (int i = 0; i < input.count && action == BTN_NONE; i++)
+                if (input.presses[i] == BTN_PAUSE || input.presses[i] == BTN_QUIT)
+                    action = input.presses[i];
+
+            switch (action)
             {
             case BTN_PAUSE:
                 game.menu_mode = 4;
@@ -478,50 +562,62 @@ int main(int argc, char *argv[])
                 while (game.menu_mode == 4)
                 {
                     view.render(&game);
-                    KEY_BOUTONS pk = view.get_input();
+                    InputState pk;
+                    view.get_input(&pk);
 
-                    if (pk == BTN_UP)
-                    {
-                        if (game.menu_selection > 0)
-                            game.menu_selection--;
-                    }
-                    else if (pk == BTN_DOWN)
-                    {
-                        if (game.menu_selection < 3)
-                            game.menu_selection++;
-                    }
-                    else if (pk == BTN_SELECT)
+                    // Rembobinage image par image, un pas par appui (répétition
+                    // du clavier comprise)
+                    if (input_pressed(&pk, BTN_LEFT))
+                        rewind_step(&rewind, &game, REWIND_STEP_TICKS);
+                    else if (input_pressed(&pk, BTN_RIGHT))
+                        rewind_step(&rewind, &game, -REWIND_STEP_TICKS);
+
+                    for (int i = 0; i < pk.count && game.menu_mode == 4; i++)
                     {
-                        switch (game.menu_selection)
+                        if (pk.presses[i] == BTN_UP)
                         {
-                        case 0:                 // Resume
-                            game.menu_mode = 0; // Reprendre le jeu
-                            break;
-                        case 1: // Settings (Sous-menu)
-                            game.menu_mode = 2;
-                            break;
-                        case 2: // High Scores (Sous-menu)
-                            game.menu_mode = 3;
-                            break;
-                        case 3: // Quit
-                            game_loop_running = 0;
-                            game.menu_mode = 0; // Sortir de la boucle pause
-                            break;
+                            if (game.menu_selection > 0)
+                                game.menu_selection--;
+                        }
+                        else if (pk.presses[i] == BTN_DOWN)
+                        {
+                            if (game.menu_selection < 3)
+                                game.menu_selection++;
+                        }
+                        else if (pk.presses[i] == BTN_SELECT)
+                        {
+                            switch (game.menu_selection)
+                            {
+                            case 0:                 // Resume
+                                game.menu_mode = 0; // Reprendre le jeu
+                                break;
+                            case 1: // Settings (Sous-menu)
+                                game.menu_mode = 2;
+                                break;
+                            case 2: // High Scores (Sous-menu)
+                                game.menu_mode = 3;
+                                break;
+                            case 3: // Quit
+                                game_loop_running = 0;
+                                game.menu_mode = 0; // Sortir de la boucle pause
+                                break;
+                            }
+                        }
+                        else if (pk.presses[i] == BTN_QUIT)
+                        {
+                            // ESC en pause -> Reprendre le jeu
+                            game.menu_mode = 0;
                         }
-                    }
-                    else if (pk == BTN_QUIT)
-                    {
-                        // ESC en pause -> Reprendre le jeu
-                        game.menu_mode = 0;
                     }
 
                     // Gestion des sous-menus PENDANT LA PAUSE (Settings / HighScores)
                     while (game.menu_mode == 2 || game.menu_mode == 3)
                     {
                         view.render(&game);
-                        KEY_BOUTONS sub = view.get_input();
+                        InputState sub;
+                        view.get_input(&sub);
                         // Retour au menu pause avec ESC
-                        if (sub == BTN_QUIT || sub == BTN_FIRE)
+                        if (input_pressed(&sub, BTN_QUIT) || input_pressed(&sub, BTN_FIRE))
                         {
                             game.menu_mode = 4;
                         }
@@ -539,57 +635,118 @@ int main(int argc, char *argv[])
 
                 if (!game_loop_running)
                     break;
+                // Reprise après rembobinage : l'historique, l'enregistrement et la
+                // relecture repartent du tick affiché
+                if (rewind.cursor > 0)
+                {
+                    rewind_commit(&rewind);
+                    if (recording_active)
+                        replay_truncate(&recording, game.tick);
+                    if (replaying)
+                        replay_seek(&replay, game.tick);
+                }
                 // Si on sort du menu pause (resume), on réinitialise l'horloge pour éviter un saut temporel
                 clock_gettime(CLOCK_MONOTONIC, &t_last);
+                accumulator_ns = 0;
+                pending_fires = 0;
+                prev_state = game;
+                PERF_FRAME_SKIP();
                 continue;
 
             case BTN_QUIT:
                 game_loop_running = 0; // Retour Launcher
                 break;
 
-            case BTN_LEFT:
-                model_move_player(&game, -1, 0);
-                break;
-            case BTN_RIGHT:
-                model_move_player(&game, 1, 0);
-                break;
-            case BTN_DOWN:
-                model_move_player(&game, 0, 1);
-                break;
-            case BTN_UP:
-                model_move_player(&game, 0, -1);
-                break;
-            case BTN_FIRE:
-                model_move_player(&game, 0, 0);
-                if (fire_timer <= 0.0f)
-                {
-                    float x = game.player.x + (game.player.width / 2);
-                    float y = game.player.y;
-                    model_fire_bullet(&game, x, y, ENTITY_BULLET_PLAYER);
-                    fire_timer = 0.01f;
-                }
-                break;
             default:
-                model_move_player(&game, 0, 0);
+                // Déplacement et tir (cumulables) : boutons tenus, appliqués à chaque tick par model_step
                 break;
             }
 
             if (!game_loop_running)
                 break;
 
-            // Update
-            model_update(&game, delta_s);
-
-            // Render
-            view.render(&game);
+            // Tir tenu (SDL) : chaque tick tire déjà. Sinon chaque appui (ncurses)
+            // vaut un tick avec BTN_FIRE, même s'il arrive sur une image sans tick
+            if (input.held & BTN_MASK(BTN_FIRE))
+                pending_fires = 0;
+            else
+                for (int i = 0; i < input.count; i++)
+                    pending_fires += input.presses[i] == BTN_FIRE;
+
+            // Update : 0 à MODEL_MAX_TICKS_PER_FRAME ticks fixes selon le temps écoulé
+            TRACE_BEGIN("update");
+            PERF_BEGIN(PERF_UPDATE);
+            int ticks = 0;
+            bool replay_finished = false;
+            while (accumulator_ns >= TICK_NANOS && ticks < MODEL_MAX_TICKS_PER_FRAME && !game.game_over)
+            {
+                // En relecture, l'entrée du tick vient du fichier (le clavier ne sert qu'à Pause / Quitter)
+                ButtonMask tick_input = input.held;
+                if (pending_fires > 0)
+                {
+                    tick_input |= BTN_MASK(BTN_FIRE);
+                    pending_fires--;
+                }
+                if (replaying && !replay_next(&replay, &tick_input))
+                {
+                    replay_finished = true;
+                    break;
+                }
+                prev_state = game;
+                model_step(&game, tick_input);
+                rewind_push(&rewind, &game);
+                if (recording_active)
+                    replay_record(&recording, tick_input);
+                accumulator_ns -= TICK_NANOS;
+                ticks++;
+            }
+            PERF_END(PERF_UPDATE);
+            TRACE_END("update");
+            if (replay_finished)
+            {
+                printf("🎬 Fin du replay : score %d (enregistré : %d)\n", game.score, replay.final_score);
+                game_loop_running = 0;
+                break;
+            }
+            // Machine trop lente : on abandonne le retard plutôt que de s'enliser
+            if (accumulator_ns >= TICK_NANOS)
+                accumulator_ns = 0;
+
+            TRACE_BEGIN("render");
+            PERF_BEGIN(PERF_RENDER);
+            TRACE_BEGIN("events");
+            dispatch_model_events(&game, &view);
+            TRACE_END("events");
+
+            // Render (interpolé entre les deux derniers ticks)
+            float alpha = (float)accumulator_ns / (float)TICK_NANOS;
+            model_interpolate(&prev_state, &game, alpha, &render_state);
+            view.render(&render_state);
+            PERF_END(PERF_RENDER);
+            TRACE_END("render");
 
             // Game Over Loop
             if (game.game_over)
             {
+                // Un enregistrement ou une relecture couvre une seule partie
+                if (recording_active)
+                {
+                    replay_save(&recording, record_path, game.score);
+                    recording_active = false;
+                }
+                if (replaying)
+                    printf("🎬 Fin du replay : score %d (enregistré : %d)\n", game.score, replay.final_score);
+                replaying = false;
+
                 while (game_loop_running)
                 {
                     view.render(&game);
-                    KEY_BOUTONS post = view.get_input();
+                    InputState post_input;
+                    view.get_input(&post_input);
+                    KEY_BOUTONS post = BTN_NONE; // premier appui décisif de l'image
+                    for (int i = 0; i < post_input.count && post == BTN_NONE; i++)
+                        if (post_input.presses[i] == BTN_QUIT || post_input.presses[i] == BTN_SELECT)
+                            post = post_input.presses[i];
                     if (post == BTN_QUIT)
                     {
                         game_loop_running = 0; // Retour Launcher
@@ -598,10 +755,15 @@ int main(int argc, char *argv[])
                     if (post == BTN_SELECT)
                     {
                         // Restart
-                        model_init(&game);
+                        model_init(&game, make_seed());
                         game.high_score = saved_high_score; // Garder le score
-                        fire_timer = 0.0f;
+                        rewind_clear(&rewind);
+                        rewind_push(&rewind, &game);
                         clock_gettime(CLOCK_MONOTONIC, &t_last);
+                        accumulator_ns = 0;
+                        pending_fires = 0;
+                        prev_state = game;
+                        PERF_FRAME_SKIP();
                         break;
                     }
                     struct timespec ts = {0, 100000000};
@@ -612,23 +774,28 @@ int main(int argc, char *argv[])
                 continue;
             }
 
-            // FPS Cap
+            // FPS Cap (le temps dormi est rattrapé par l'accumulateur au tour suivant)
             clock_gettime(CLOCK_MONOTONIC, &t_after);
-            int64_t frame_elapsed = (t_after.tv_sec - t_now.tv_sec) * 1000000000000LL + (t_after.tv_nsec - t_now.tv_nsec);
+            int64_t frame_elapsed = (t_after.tv_sec - t_now.tv_sec) * 1000000000LL + (t_after.tv_nsec - t_now.tv_nsec);
             int64_t sleep_ns = FRAME_NANOS - frame_elapsed;
             if (sleep_ns > 0)
             {
+                TRACE_BEGIN("sleep");
                 struct timespec ts_sleep;
-                ts_sleep.tv_sec = sleep_ns / 1000000000000LL;
-                ts_sleep.tv_nsec = sleep_ns % 1000000000000LL;
+                ts_sleep.tv_sec = sleep_ns / 1000000000LL;
+                ts_sleep.tv_nsec = sleep_ns % 1000000000LL;
                 nanosleep(&ts_sleep, NULL);
+                TRACE_END("sleep");
             }
-            clock_gettime(CLOCK_MONOTONIC, &t_last);
         }
 
         // Fin de la session de jeu
         view.close();
 
+        if (recording_active)
+            replay_save(&recording, record_path, game.score);
+        replaying = false;
+
         // SAUVEGARDE DU HIGH SCORE SI BATTU
         if (game.score > saved_high_score)
         {
@@ -643,6 +810,9 @@ int main(int argc, char *argv[])
         }
     }
 
+    replay_free(&replay);
+    replay_free(&recording);
+    rewind_free(&rewind);
     printf("👋 Fin de l'application.\n");
     return 0;
 }
\ No newline at end of file
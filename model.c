@@ -4,34 +4,82 @@
 //  Created by Cakir on 24/12/2025.
 //
 
-#include <stdio.h>
 #include "model.h"
 #include <stdbool.h>
 #include <controller.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h> // Pour abs()
+#include "kernels.h"
+#include "trace.h"
 
-#define PLAYER_W 90
-#define PLAYER_H 100
-#define ALIEN_W 40
-#define ALIEN_H 50
-#define BULLET_W 10
-#define BULLET_H 38
 #define ALIEN_DROP_DOWN 20.0f
-#define EXPLOSION_SIZE 59
 #define RESPAWN_DELAY 4.0f
-#define ITEMS_SIZE 59
 
-// Audio callbacks (set by the view layer)
-static void (*cb_play_item)(void) = NULL;
-static void (*cb_play_explosion)(void) = NULL;
-static void (*cb_play_shoot)(void) = NULL;
+// --- FILE D'ÉVÉNEMENTS ---
 
-void model_set_audio_callbacks(void (*on_item)(void), void (*on_explosion)(void), void (*on_shoot)(void))
+static void emit_event(GameModel *game, ModelEventType type, int32_t arg, float x, float y)
 {
-    cb_play_item = on_item;
-    cb_play_explosion = on_explosion;
-    cb_play_shoot = on_shoot;
+    ModelEventQueue *q = &game->events;
+    if (q->head - q->tail == MODEL_EVENT_CAPACITY)
+    {
+        q->dropped++;
+        return;
+    }
+    q->items[q->head++ & (MODEL_EVENT_CAPACITY - 1)] = (ModelEvent){(uint8_t)type, arg, game->tick, x, y};
+}
+
+bool model_poll_event(GameModel *game, ModelEvent *out)
+{
+    ModelEventQueue *q = &game->events;
+    if (q->head == q->tail)
+        return false;
+    *out = q->items[q->tail++ & (MODEL_EVENT_CAPACITY - 1)];
+    return true;
+}
+
+// --- ÉMETTEURS ---
+// Chaque émetteur décompte le temps jusqu'à son prochain événement ; le pas
+// de temps ne change que le nombre d'événements par appel, pas leur cadence.
+
+static float emitter_interval(const Emitter *e, Rng *rng)
+{
+    if (e->mode == EMIT_POISSON)
+        return -logf(1.0f - rng_float(rng)) / e->rate;
+    return 1.0f / e->rate;
+}
+
+static void emitter_start(Emitter *e, EmitterMode mode, float rate, Rng *rng)
+{
+    e->mode = (uint8_t)mode;
+    e->rate = rate;
+    e->wait = emitter_interval(e, rng);
+}
+
+static void emitter_stop(Emitter *e)
+{
+    e->rate = 0.0f;
+}
+
+// Nombre d'événements échus pendant dt (au plus EMITTER_MAX_EVENTS : au-delà,
+// le retard est abandonné plutôt que rattrapé d'un coup)
+static int emitter_update(Emitter *e, float dt, Rng *rng)
+{
+    if (e->rate <= 0.0f)
+        return 0;
+    e->wait -= dt;
+    int n = 0;
+    while (e->wait <= 0.0f)
+    {
+        n++;
+        if (n == EMITTER_MAX_EVENTS)
+        {
+            e->wait = emitter_interval(e, rng);
+            break;
+        }
+        e->wait += emitter_interval(e, rng);
+    }
+    return n;
 }
 
 // Fonction pour faire apparaître le BOSS
@@ -50,48 +98,113 @@ static void spawn_boss(GameModel *game)
     game->boss.hp = 100;
 
     // 3. Vitesse d'approche RAPIDE (Même vitesse que combat)
-    // On utilise dy comme un "Flag d'état" : 0 = Approche, 1 = Combat
+    // La phase (approche / combat) est dans game->boss_phase
     // ALIEN_SPEED * 1.3f est la vitesse de combat définie plus bas
     float approach_speed = ALIEN_SPEED * 2.4f;
     game->boss.dx = -approach_speed; // Avance vers la gauche (VITE)
-    game->boss.dy = 0;               // État 0 : En approche
+    game->boss.dy = 0;               // le boss ne bouge qu'horizontalement
+    game->boss_phase = BOSS_APPROACH;
+    emitter_stop(&game->boss_fire); // il ne tire qu'une fois en position
 
-    printf("⚠️ ALERTE : BOSS ARRIVE ! (HP: %d)\n", game->boss.hp);
+    emit_event(game, MODEL_EVENT_BOSS_PHASE, BOSS_APPROACH, game->boss.x, game->boss.y);
 }
 
 // Helper: spawn aliens grid (same layout as init)
 static void spawn_aliens(GameModel *game)
 {
-    int rows = 5;
-    int cols = 11;
-    int count = 0;
+    AlienFormation *f = &game->aliens;
+    f->origin_x = FORMATION_START_X;
+    f->origin_y = FORMATION_START_Y;
+    f->left_col = 0;
+    f->right_col = FORMATION_COLS - 1;
+    f->bottom_row = FORMATION_ROWS - 1;
+    f->alive_count = MAX_ALIENS;
+    memset(f->col_count, FORMATION_ROWS, sizeof(f->col_count));
+    memset(f->row_count, FORMATION_COLS, sizeof(f->row_count));
+    for (int c = 0; c < FORMATION_COLS; c++)
+    {
+        f->col_bottom[c] = FORMATION_ROWS - 1;
+        f->live_cols[c] = (int8_t)c;
+        f->live_col_pos[c] = (int8_t)c;
+    }
+    f->live_col_count = FORMATION_COLS;
+
+    memset(f->alive, 0, sizeof(f->alive));
+    for (int i = 0; i < MAX_ALIENS; i++)
+        pool_set(f->alive, i);
+
+    emitter_start(&game->alien_fire, EMIT_POISSON, ALIEN_FIRE_RATE, &game->rng);
+}
+
+// Vague vide (niveau boss)
+static void formation_clear(AlienFormation *f)
+{
+    memset(f->alive, 0, sizeof(f->alive));
+    memset(f->col_count, 0, sizeof(f->col_count));
+    memset(f->row_count, 0, sizeof(f->row_count));
+    memset(f->col_bottom, -1, sizeof(f->col_bottom));
+    f->live_col_count = 0;
+    f->alive_count = 0;
+    f->left_col = f->right_col = f->bottom_row = -1;
+}
 
-    float start_x = 100;
-    float start_y = 50;
-    float gap_x = 28; // espacement horizontal augmenté
-    float gap_y = 22; // espacement vertical augmenté
+// Les bords ne bougent que quand la colonne (ou rangée) extrême se vide :
+// chaque bord ne fait qu'avancer, coût amorti O(1) par mort.
+static void formation_kill(AlienFormation *f, int i)
+{
+    if (!pool_test(f->alive, i))
+        return;
+    int c = i % FORMATION_COLS;
+    int r = i / FORMATION_COLS;
+    pool_clear(f->alive, i);
+    f->alive_count--;
+    f->col_count[c]--;
+    f->row_count[r]--;
+
+    if (f->col_count[c] == 0)
+    {
+        // Colonne vide : retirée de la liste des tireurs par échange avec la dernière
+        int pos = f->live_col_pos[c];
+        int last = f->live_cols[--f->live_col_count];
+        f->live_cols[pos] = (int8_t)last;
+        f->live_col_pos[last] = (int8_t)pos;
+        f->col_bottom[c] = -1;
+    }
+    else if (r == f->col_bottom[c])
+    {
+        // Le tireur est mort : celui du dessus prend sa place
+        while (!pool_test(f->alive, f->col_bottom[c] * FORMATION_COLS + c))
+            f->col_bottom[c]--;
+    }
 
-    for (int r = 0; r < rows; r++)
+    if (f->alive_count == 0)
     {
-        for (int c = 0; c < cols; c++)
-        {
-            if (count >= MAX_ALIENS)
-                break;
-            Entity *alien = &game->aliens[count];
-            alien->x = start_x + c * (ALIEN_W + gap_x);
-            alien->y = start_y + r * (ALIEN_H + gap_y);
-            alien->width = ALIEN_W;
-            alien->height = ALIEN_H;
-            alien->active = true;
-            alien->type = ENTITY_ALIEN;
-            count++;
-        }
+        f->left_col = f->right_col = f->bottom_row = -1;
+        return;
     }
+    while (f->col_count[f->left_col] == 0)
+        f->left_col++;
+    while (f->col_count[f->right_col] == 0)
+        f->right_col--;
+    while (f->row_count[f->bottom_row] == 0)
+        f->bottom_row--;
+}
+
+// Bas de la rangée vivante la plus basse (ne pas appeler sur une vague vide)
+static inline float formation_bottom(const AlienFormation *f)
+{
+    return f->origin_y + (float)(f->bottom_row * FORMATION_PITCH_Y) + ALIEN_H;
 }
 
 // Initialise toutes les variables (positions de départ)
-void model_init(GameModel *game)
+void model_init(GameModel *game, uint64_t seed)
 {
+    game->events.head = game->events.tail = 0;
+    game->events.dropped = 0;
+
+    game->seed = seed;
+    rng_seed(&game->rng, seed, RNG_STREAM_MODEL);
+
     // Reset game state
     game->score = 0;
     game->lives = 3;
@@ -112,23 +225,24 @@ void model_init(GameModel *game)
 
     // Pas de boss au niveau 1
     game->boss.active = false;
+    emitter_stop(&game->boss_fire);
 
     // Init Aliens
     spawn_aliens(game);
 
-    for (int i = 0; i < MAX_BULLETS; i++)
-    {
-        game->bullets[i].active = false;
-    }
-    for (int i = 0; i < EXPLOSION_MAX; i++)
-    {
-        game->explosions[i].active = false;
-    }
+    // Les kernels d'intégration lisent aussi les slots libres : pas de valeurs indéterminées
+    memset(&game->bullets, 0, sizeof(game->bullets));
+    memset(&game->explosions, 0, sizeof(game->explosions));
+    memset(&game->items, 0, sizeof(game->items));
+    slot_pool_init(&game->bullets.slots, MAX_BULLETS, POOL_FULL_REJECT);
+    slot_pool_init(&game->explosions.slots, EXPLOSION_MAX, POOL_FULL_DROP_OLDEST);
     // Items
-    for (int i = 0; i < ITEMS_MAX; i++)
-    {
-        game->items[i].active = false;
-    }
+    slot_pool_init(&game->items.slots, ITEMS_MAX, POOL_FULL_REJECT);
+
+    memset(&game->collision_stats, 0, sizeof(game->collision_stats));
+    game->fire_ready = true;
+    game->tick = 0;
+    timer_wheel_init(&game->timers, game->tick);
 
     game->menu_mode = 0;
     game->menu_selection = 0;
@@ -143,74 +257,398 @@ static void level_up(GameModel *game)
     game->alien_speed_multiplier *= 1.15f;
 
     // Nettoyage des balles
-    for (int i = 0; i < MAX_BULLETS; i++)
-        game->bullets[i].active = false;
+    slot_pool_release_all(&game->bullets.slots);
 
-    game->respawn_timer = 0.0f;
+    emit_event(game, MODEL_EVENT_LEVEL_UP, game->level, 0.0f, 0.0f);
 
     // LOGIQUE BOSS : Tous les 3 niveaux (3, 6, 9...)
     if (game->level % 3 == 0)
     {
-        printf("➡️ Niveau %d : BOSS BATTLE !\n", game->level);
         // Désactiver les aliens s'il y en a (sécurité)
-        for (int i = 0; i < MAX_ALIENS; i++)
-            game->aliens[i].active = false;
+        formation_clear(&game->aliens);
 
         spawn_boss(game);
     }
     else
     {
-        printf("➡️ Niveau suivant ! Level %d\n", game->level);
         game->boss.active = false; // S'assurer que le boss est parti
         spawn_aliens(game);
     }
 }
 
-static bool check_collision(Entity *a, Entity *b)
+// Test AABB sur des champs déjà extraits des pools (pas d'Entity à construire)
+static inline bool check_collision(float ax, float ay, float aw, float ah, float bx, float by, float bw, float bh)
 {
-    if (!a->active || !b->active)
-        return false;
+    return (ax < bx + bw &&
+            ax + aw > bx &&
+            ay < by + bh &&
+            ay + ah > by);
+}
 
-    return (a->x < b->x + b->width &&
-            a->x + a->width > b->x &&
-            a->y < b->y + b->height &&
-            a->y + a->height > b->y);
+// --- COLLISION CONTINUE DES TIRS ---
+// Un tir rapide peut parcourir plus que la hauteur d'un alien en un tick :
+// on teste tout le segment y0 -> y1 parcouru pendant le tick (les tirs ne
+// bougent que verticalement), la cible étant fixe à sa position du tick.
+
+// Instant d'entrée t dans [0, 1) de la boîte (x, y0 -> y1, w, h) dans la boîte
+// fixe b, ou -1 si elles ne se touchent pas pendant le tick
+static inline float sweep_vertical(float x, float y0, float y1, float w, float h, float bx, float by, float bw, float bh)
+{
+    if (x >= bx + bw || x + w <= bx)
+        return -1.0f;
+    float v = y1 - y0;
+    if (v == 0.0f)
+        return (y0 < by + bh && y0 + h > by) ? 0.0f : -1.0f;
+
+    // Recouvrement vertical tant que by - h < y(t) < by + bh
+    float ta = (by - h - y0) / v;
+    float tb = (by + bh - y0) / v;
+    float t_in = fmaxf(fminf(ta, tb), 0.0f);
+    float t_out = fminf(fmaxf(ta, tb), 1.0f);
+    return t_in < t_out ? t_in : -1.0f;
 }
 
-void spawn_explosion(GameModel *game, float x, float y)
+// Position du tir au début du tick (le kernel d'intégration l'a déjà avancé)
+static inline float bullet_prev_y(const BulletPool *b, int i, float dt)
+{
+    return b->y[i] - b->dy[i] * dt;
+}
+
+// Alien vivant touché le plus tôt par le tir balayé (x, y0 -> y1, w, h), ou -1.
+// Seules les cellules de la formation couvertes par le segment sont testées.
+static int formation_sweep(const AlienFormation *f, float x, float y0, float y1, float w, float h, float *t_hit)
 {
-    for (int i = 0; i < EXPLOSION_MAX; i++)
+    float lx = x - f->origin_x;
+    float ly = fminf(y0, y1) - f->origin_y;
+    float lh = fabsf(y1 - y0) + h;
+    int c0 = (int)floorf((lx - ALIEN_W) / FORMATION_PITCH_X);
+    int c1 = (int)floorf((lx + w) / FORMATION_PITCH_X);
+    int r0 = (int)floorf((ly - ALIEN_H) / FORMATION_PITCH_Y);
+    int r1 = (int)floorf((ly + lh) / FORMATION_PITCH_Y);
+    if (c0 < 0)
+        c0 = 0;
+    if (r0 < 0)
+        r0 = 0;
+    if (c1 >= FORMATION_COLS)
+        c1 = FORMATION_COLS - 1;
+    if (r1 >= FORMATION_ROWS)
+        r1 = FORMATION_ROWS - 1;
+
+    int best = -1;
+    float best_t = 2.0f;
+    for (int r = r0; r <= r1; r++)
     {
-        if (!game->explosions[i].active)
+        for (int c = c0; c <= c1; c++)
         {
-            game->explosions[i].active = true;
-            game->explosions[i].type = ENTITY_EXPLOSION;
-            game->explosions[i].x = x;
-            game->explosions[i].y = y;
-            game->explosions[i].width = EXPLOSION_SIZE;
-            game->explosions[i].height = EXPLOSION_SIZE;
-            game->explosions[i].dx = EXPLOSION_TIME;
-            if (cb_play_explosion)
-                cb_play_explosion();
-            break;
+            int i = r * FORMATION_COLS + c;
+            if (!pool_test(f->alive, i))
+                continue;
+            float t = sweep_vertical(x, y0, y1, w, h, formation_alien_x(f, i), formation_alien_y(f, i), ALIEN_W, ALIEN_H);
+            if (t >= 0.0f && t < best_t)
+            {
+                best = i;
+                best_t = t;
+            }
         }
     }
+    *t_hit = best_t;
+    return best;
+}
+
+// --- BROADPHASE (grille uniforme) ---
+
+typedef struct
+{
+    uint16_t ref;
+    uint8_t c0, c1, r0, r1;
+} GridInsert;
+
+// Cellules couvertes par une boîte, bornées à la grille. Borner l'insertion
+// ET la requête garde le test exact : deux boîtes qui se chevauchent
+// partagent toujours au moins une cellule bornée.
+static inline void grid_range(float x, float y, float w, float h, int *c0, int *c1, int *r0, int *r1)
+{
+    const float inv = 1.0f / GRID_CELL_SIZE;
+    int a = (int)(x * inv), b = (int)((x + w) * inv);
+    int c = (int)(y * inv), d = (int)((y + h) * inv);
+    *c0 = a < 0 ? 0 : (a >= GRID_COLS ? GRID_COLS - 1 : a);
+    *c1 = b < 0 ? 0 : (b >= GRID_COLS ? GRID_COLS - 1 : b);
+    *r0 = c < 0 ? 0 : (c >= GRID_ROWS ? GRID_ROWS - 1 : c);
+    *r1 = d < 0 ? 0 : (d >= GRID_ROWS ? GRID_ROWS - 1 : d);
+}
+
+static inline int grid_push(GridInsert *list, int n, uint16_t ref, float x, float y, float w, float h)
+{
+    int c0, c1, r0, r1;
+    grid_range(x, y, w, h, &c0, &c1, &r0, &r1);
+    list[n] = (GridInsert){ref, (uint8_t)c0, (uint8_t)c1, (uint8_t)r0, (uint8_t)r1};
+    return n + 1;
+}
+
+// Reconstruit la grille (tri par comptage) avec boss, items et tirs ennemis
+static void grid_build(GameModel *game, float dt)
+{
+    CollisionGrid *g = &game->grid;
+    GridInsert list[1 + ITEMS_MAX + MAX_BULLETS];
+    int n = 0;
+    int player_targets;
+
+    if (game->boss.active)
+        n = grid_push(list, n, GRID_REF(GRID_REF_BOSS, 0), game->boss.x, game->boss.y, game->boss.width, game->boss.height);
+    player_targets = n;
+    for (int i = slot_next(&game->items.slots, 0); i >= 0; i = slot_next(&game->items.slots, i + 1))
+        n = grid_push(list, n, GRID_REF(GRID_REF_ITEM, i), game->items.x[i], game->items.y[i], ITEMS_SIZE, ITEMS_SIZE);
+    for (int i = slot_next(&game->bullets.slots, 0); i >= 0; i = slot_next(&game->bullets.slots, i + 1))
+        if (game->bullets.type[i] != ENTITY_BULLET_PLAYER)
+        {
+            float y0 = bullet_prev_y(&game->bullets, i, dt);
+            float y1 = game->bullets.y[i];
+            n = grid_push(list, n, GRID_REF(GRID_REF_ENEMY_BULLET, i), game->bullets.x[i], fminf(y0, y1),
+                          BULLET_W, fabsf(y1 - y0) + BULLET_H);
+        }
+
+    // Sans grille, le joueur testerait chaque item et chaque tir ennemi
+    if (game->player.active)
+        game->collision_stats.brute_force_pairs += n - player_targets;
+
+    // 1. Comptage par cellule (décalé d'un cran pour la somme préfixe)
+    memset(g->cell_start, 0, sizeof(g->cell_start));
+    for (int k = 0; k < n; k++)
+        for (int r = list[k].r0; r <= list[k].r1; r++)
+            for (int c = list[k].c0; c <= list[k].c1; c++)
+                g->cell_start[r * GRID_COLS + c + 1]++;
+
+    // 2. Somme préfixe
+    for (int c = 0; c < GRID_CELLS; c++)
+        g->cell_start[c + 1] += g->cell_start[c];
+
+    // 3. Remplissage
+    uint16_t cursor[GRID_CELLS];
+    memcpy(cursor, g->cell_start, sizeof(cursor));
+    for (int k = 0; k < n; k++)
+        for (int r = list[k].r0; r <= list[k].r1; r++)
+            for (int c = list[k].c0; c <= list[k].c1; c++)
+                g->entries[cursor[r * GRID_COLS + c]++] = list[k].ref;
+}
+
+void spawn_explosion(GameModel *game, float x, float y)
+{
+    ExplosionPool *ex = &game->explosions;
+    uint32_t evicted = ex->slots.evicted;
+    int i = slot_acquire(&ex->slots);
+    if (i < 0)
+        return;
+    // Slot recyclé (pool plein) : l'ancienne explosion n'a plus à disparaître
+    if (ex->slots.evicted != evicted)
+        timer_cancel(&game->timers, ex->timer[i]);
+    ex->x[i] = x;
+    ex->y[i] = y;
+    ex->timer[i] = (int16_t)timer_add(&game->timers, TIMER_TICKS(EXPLOSION_TIME, MODEL_TICK_HZ),
+                                      TIMER_EXPLOSION_END, (uint16_t)i);
+    emit_event(game, MODEL_EVENT_EXPLOSION, 0, x, y);
 }
 
 void init_items(GameModel *game, float x, float y)
 {
-    for (int i = 0; i < ITEMS_MAX; i++)
+    ItemPool *items = &game->items;
+    int i = slot_acquire(&items->slots);
+    if (i < 0)
+        return;
+    items->x[i] = x - ITEMS_SIZE / 2.0f;
+    items->y[i] = y - ITEMS_SIZE / 2.0f;
+    items->dy[i] = 900.0f;
+}
+
+// Tirs du joueur contre le boss (via la grille) et la formation (par calcul),
+// sur tout le segment parcouru pendant le tick : la première cible rencontrée gagne
+static void collide_player_bullets(GameModel *game, float dt)
+{
+    BulletPool *bullets = &game->bullets;
+    AlienFormation *aliens = &game->aliens;
+    CollisionGrid *g = &game->grid;
+    CollisionStats *st = &game->collision_stats;
+
+    for (int i = slot_next(&bullets->slots, 0); i >= 0; i = slot_next(&bullets->slots, i + 1))
+    {
+        if (bullets->type[i] != ENTITY_BULLET_PLAYER)
+            continue;
+
+        float bx = bullets->x[i];
+        float y0 = bullet_prev_y(bullets, i, dt);
+        float y1 = bullets->y[i];
+        int c0, c1, r0, r1;
+        grid_range(bx, fminf(y0, y1), BULLET_W, fabsf(y1 - y0) + BULLET_H, &c0, &c1, &r0, &r1);
+
+        st->brute_force_pairs += game->boss.active ? 1 : MAX_ALIENS;
+
+        float t_boss = -1.0f;
+        for (int r = r0; r <= r1; r++)
+        {
+            for (int c = c0; c <= c1; c++)
+            {
+                int cell = r * GRID_COLS + c;
+                for (int k = g->cell_start[cell]; k < g->cell_start[cell + 1]; k++)
+                {
+                    if (GRID_REF_KIND(g->entries[k]) == GRID_REF_BOSS)
+                    {
+                        st->candidate_pairs++;
+                        if (game->boss.active)
+                            t_boss = sweep_vertical(bx, y0, y1, BULLET_W, BULLET_H, game->boss.x, game->boss.y,
+                                                    game->boss.width, game->boss.height);
+                    }
+                }
+            }
+        }
+
+        // Contre ALIENS : la cellule touchée se déduit de la position relative à la formation
+        int j = -1;
+        float t_alien = 2.0f;
+        if (aliens->alive_count > 0)
+        {
+            st->candidate_pairs++;
+            j = formation_sweep(aliens, bx, y0, y1, BULLET_W, BULLET_H, &t_alien);
+        }
+
+        // Contre BOSS (s'il est rencontré avant tout alien)
+        if (t_boss >= 0.0f && t_boss <= t_alien)
+        {
+            float by = y0 + (y1 - y0) * t_boss; // point d'impact
+            st->confirmed_hits++;
+            slot_release(&bullets->slots, i);
+            spawn_explosion(game, bx, by); // Petite explosion impact
+            emit_event(game, MODEL_EVENT_HIT, ENTITY_BOSS, bx, by);
+            game->boss.hp--;
+
+            if (game->boss.hp <= 0)
+            {
+                game->boss.active = false;
+                game->score += 10000; // BONUS 10,000 POINTS
+                spawn_explosion(game, game->boss.x, game->boss.y);
+                // Chance de drop item
+                init_items(game, game->boss.x + BOSS_W / 2, game->boss.y + BOSS_H / 2);
+                // Niveau suivant immédiat (vide aussi les balles : la boucle s'arrête d'elle-même)
+                level_up(game);
+            }
+            continue;
+        }
+
+        if (j >= 0)
+        {
+            float ax = formation_alien_x(aliens, j);
+            float ay = formation_alien_y(aliens, j);
+            st->confirmed_hits++;
+            formation_kill(aliens, j);
+            slot_release(&bullets->slots, i);
+            emit_event(game, MODEL_EVENT_HIT, ENTITY_ALIEN, ax, ay);
+            spawn_explosion(game, ax, ay);
+            game->score += 100;
+            if (rng_range(&game->rng, 100) < 5)
+                init_items(game, ax + ALIEN_W / 2.0f, ay + ALIEN_H / 2.0f);
+        }
+    }
+}
+
+// Le joueur touché par un tir ennemi
+static void player_hit(GameModel *game)
+{
+    Entity *player = &game->player;
+    emit_event(game, MODEL_EVENT_HIT, ENTITY_PLAYER, player->x, player->y);
+    if (player->shield)
+    {
+        player->shield = false;
+        spawn_explosion(game, player->x, player->y);
+        return;
+    }
+
+    player->active = false;
+    spawn_explosion(game, player->x, player->y);
+    game->lives -= 1;
+    if (game->lives <= 0)
+    {
+        game->game_over = true;
+        if (game->score > game->high_score)
+            game->high_score = game->score;
+    }
+    else
+    {
+        // Le joueur revient au centre après RESPAWN_DELAY (voir run_timers)
+        timer_add(&game->timers, TIMER_TICKS(RESPAWN_DELAY, MODEL_TICK_HZ), TIMER_PLAYER_RESPAWN, 0);
+    }
+}
+
+// Le joueur contre les tirs ennemis puis les items de ses cellules
+static void collide_player(GameModel *game, float dt)
+{
+    Entity *player = &game->player;
+    BulletPool *bullets = &game->bullets;
+    ItemPool *items = &game->items;
+    CollisionGrid *g = &game->grid;
+    CollisionStats *st = &game->collision_stats;
+    int c0, c1, r0, r1;
+
+    // TIRS ENNEMIS (Alien ou Boss) : un seul impact par tick, celui du tir
+    // qui atteint le joueur le plus tôt dans le tick
+    if (player->active)
+    {
+        int first = -1;
+        float first_t = 2.0f;
+        grid_range(player->x, player->y, player->width, player->height, &c0, &c1, &r0, &r1);
+        for (int r = r0; r <= r1; r++)
+        {
+            for (int c = c0; c <= c1; c++)
+            {
+                int cell = r * GRID_COLS + c;
+                for (int k = g->cell_start[cell]; k < g->cell_start[cell + 1]; k++)
+                {
+                    uint16_t ref = g->entries[k];
+                    int i = GRID_REF_INDEX(ref);
+                    if (GRID_REF_KIND(ref) != GRID_REF_ENEMY_BULLET || !pool_test(bullets->slots.live, i))
+                        continue;
+                    st->candidate_pairs++;
+                    float t = sweep_vertical(bullets->x[i], bullet_prev_y(bullets, i, dt), bullets->y[i], BULLET_W,
+                                             BULLET_H, player->x, player->y, player->width, player->height);
+                    if (t >= 0.0f && t < first_t)
+                    {
+                        first = i;
+                        first_t = t;
+                    }
+                }
+            }
+        }
+        if (first >= 0)
+        {
+            st->confirmed_hits++;
+            slot_release(&bullets->slots, first);
+            player_hit(game);
+        }
+    }
+
+    // --- ITEMS ---
+    if (!player->active)
+        return;
+    grid_range(player->x, player->y, player->width, player->height, &c0, &c1, &r0, &r1);
+    for (int r = r0; r <= r1; r++)
     {
-        if (!game->items[i].active)
+        for (int c = c0; c <= c1; c++)
         {
-            game->items[i].active = true;
-            game->items[i].type = ENTITY_ITEMS;
-            game->items[i].x = x - ITEMS_SIZE / 2.0f;
-            game->items[i].y = y - ITEMS_SIZE / 2.0f;
-            game->items[i].width = ITEMS_SIZE;
-            game->items[i].height = ITEMS_SIZE;
-            game->items[i].dx = 0;
-            game->items[i].dy = 900.0f;
+            int cell = r * GRID_COLS + c;
+            for (int k = g->cell_start[cell]; k < g->cell_start[cell + 1]; k++)
+            {
+                uint16_t ref = g->entries[k];
+                int i = GRID_REF_INDEX(ref);
+                if (GRID_REF_KIND(ref) != GRID_REF_ITEM || !pool_test(items->slots.live, i))
+                    continue;
+                st->candidate_pairs++;
+                if (check_collision(items->x[i], items->y[i], ITEMS_SIZE, ITEMS_SIZE,
+                                    player->x, player->y, player->width, player->height))
+                {
+                    st->confirmed_hits++;
+                    player->shield = true;
+                    game->score += 50;
+                    slot_release(&items->slots, i);
+                    emit_event(game, MODEL_EVENT_PICKUP, 0, items->x[i], items->y[i]);
+                }
+            }
         }
     }
 }
@@ -222,6 +660,7 @@ void model_update(GameModel *game, float delta_time)
         return;
 
     // --- A. JOUEUR ---
+    TRACE_BEGIN("player");
     game->player.x += game->player.dx * delta_time;
     game->player.y += game->player.dy * delta_time;
 
@@ -233,20 +672,22 @@ void model_update(GameModel *game, float delta_time)
         game->player.y = 0;
     if (game->player.y + game->player.height > GAME_HEIGHT)
         game->player.y = GAME_HEIGHT - game->player.height;
+    TRACE_END("player");
 
     // --- GESTION BOSS OU ALIENS ---
+    TRACE_BEGIN("aliens_boss");
     if (game->boss.active)
     {
         game->boss.x += game->boss.dx * delta_time;
 
         // PHASE 1 : APPROCHE (Boss arrive de la droite)
-        if (game->boss.dy == 0)
+        if (game->boss_phase == BOSS_APPROACH)
         {
             // Vérifie si le Boss a atteint le milieu de l'écran
             if (game->boss.x + game->boss.width / 2 <= GAME_WIDTH / 2)
             {
                 // ACTIVATION DU BOSS !
-                game->boss.dy = 1; // Passe en mode Combat (État 1)
+                game->boss_phase = BOSS_COMBAT;
 
                 // Vitesse augmentée : Plus rapide que les Aliens normaux (800)
                 // Par exemple 1000 pixels/sec
@@ -254,8 +695,9 @@ void model_update(GameModel *game, float delta_time)
 
                 // Continue vers la gauche ou repart aléatoirement ? On continue pour la fluidité
                 game->boss.dx = -combat_speed;
+                emitter_start(&game->boss_fire, EMIT_POISSON, BOSS_FIRE_RATE, &game->rng);
 
-                printf("⚠️ BOSS ACTIVÉ ! MODE COMBAT ENGAGÉ !\n");
+                emit_event(game, MODEL_EVENT_BOSS_PHASE, BOSS_COMBAT, game->boss.x, game->boss.y);
             }
         }
         // PHASE 2 : COMBAT (Boss activé)
@@ -274,7 +716,7 @@ void model_update(GameModel *game, float delta_time)
             }
 
             // TIRS : Maintenant qu'il est activé, il tire n'importe où
-            if ((rand() % 100) < 5)
+            for (int shots = emitter_update(&game->boss_fire, delta_time, &game->rng); shots > 0; shots--)
             {
                 float x = game->boss.x + game->boss.width / 2.0f;
                 float y = game->boss.y + game->boss.height;
@@ -285,216 +727,103 @@ void model_update(GameModel *game, float delta_time)
     else
     {
         // LOGIQUE ALIENS CLASSIQUE (seulement si pas de boss)
-        for (int i = 0; i < MAX_ALIENS; i++)
-        {
-            if (game->aliens[i].active)
-            {
-                game->aliens[i].x += (ALIEN_SPEED * game->alien_speed_multiplier * game->alien_direction) * delta_time;
-            }
-        }
+        // Toute la vague bouge d'un bloc : une seule mise à jour de l'origine
+        AlienFormation *aliens = &game->aliens;
+        aliens->origin_x += (ALIEN_SPEED * game->alien_speed_multiplier * game->alien_direction) * delta_time;
 
         bool touch_edge = false;
-        for (int i = 0; i < MAX_ALIENS; i++)
+        if (aliens->left_col >= 0)
         {
-            if (!game->aliens[i].active)
-                continue;
-            if (game->alien_direction == 1 && game->aliens[i].x + game->aliens[i].width >= GAME_WIDTH - 10)
-            {
+            float left = aliens->origin_x + (float)(aliens->left_col * FORMATION_PITCH_X);
+            float right = aliens->origin_x + (float)(aliens->right_col * FORMATION_PITCH_X) + ALIEN_W;
+            if (game->alien_direction == 1 && right >= GAME_WIDTH - 10)
                 touch_edge = true;
-                break;
-            }
-            if (game->alien_direction == -1 && game->aliens[i].x <= 10)
-            {
+            if (game->alien_direction == -1 && left <= 10)
                 touch_edge = true;
-                break;
-            }
         }
 
         if (touch_edge)
         {
             game->alien_direction *= -1;
-            for (int i = 0; i < MAX_ALIENS; i++)
-            {
-                if (game->aliens[i].active)
-                {
-                    game->aliens[i].y += ALIEN_DROP_DOWN;
-                    game->aliens[i].x += (game->alien_direction * 5);
-                }
-            }
+            aliens->origin_y += ALIEN_DROP_DOWN;
+            aliens->origin_x += (game->alien_direction * 5);
         }
 
-        if ((rand() % 100) < 4)
+        // Comme dans l'original : une colonne vivante au hasard, son alien le plus bas tire
+        int shots = emitter_update(&game->alien_fire, delta_time, &game->rng);
+        for (; shots > 0 && aliens->live_col_count > 0; shots--)
         {
-            int random_index = rand() % MAX_ALIENS;
-            if (game->aliens[random_index].active)
-            {
-                float x = game->aliens[random_index].x + ALIEN_W / 2;
-                float y = game->aliens[random_index].y + ALIEN_H;
-                model_fire_bullet(game, x, y, ENTITY_BULLET_ALIEN);
-            }
-
-            // Game Over si alien touche le bas
-            if (game->aliens[random_index].active && (game->aliens[random_index].y + ALIEN_H >= game->player.y))
-            {
-                if (game->player.shield)
-                {
-                    game->player.shield = false;
-                    game->aliens[random_index].active = false;
-                    spawn_explosion(game, game->aliens[random_index].x, game->aliens[random_index].y);
-                }
-                else
-                {
-                    game->game_over = true;
-                    if (game->score > game->high_score)
-                        game->high_score = game->score;
-                }
-            }
+            int c = aliens->live_cols[rng_range(&game->rng, (uint32_t)aliens->live_col_count)];
+            int shooter = aliens->col_bottom[c] * FORMATION_COLS + c;
+            float x = formation_alien_x(aliens, shooter) + ALIEN_W / 2;
+            float y = formation_alien_y(aliens, shooter) + ALIEN_H;
+            model_fire_bullet(game, x, y, ENTITY_BULLET_ALIEN);
         }
-    }
-
-    // --- C. BALLES & COLLISIONS ---
-    for (int i = 0; i < MAX_BULLETS; i++)
-    {
-        Entity *b = &game->bullets[i];
 
-        if (b->active)
+        // Game Over si la rangée vivante la plus basse touche la ligne du joueur.
+        // Le bouclier sacrifie toute cette rangée.
+        if (aliens->bottom_row >= 0 && formation_bottom(aliens) >= game->player.y)
         {
-            b->y += b->dy * delta_time;
-
-            if (b->y < 0 || b->y > GAME_HEIGHT)
-            {
-                b->active = false;
-                continue;
-            }
-
-            // TIR DU JOUEUR
-            if (b->type == ENTITY_BULLET_PLAYER)
+            if (game->player.shield)
             {
-                // Contre BOSS
-                if (game->boss.active && check_collision(b, &game->boss))
-                {
-                    b->active = false;
-                    spawn_explosion(game, b->x, b->y); // Petite explosion impact
-                    game->boss.hp--;
-
-                    if (game->boss.hp <= 0)
-                    {
-                        game->boss.active = false;
-                        game->score += 10000; // BONUS 10,000 POINTS
-                        spawn_explosion(game, game->boss.x, game->boss.y);
-                        // Chance de drop item
-                        init_items(game, game->boss.x + BOSS_W / 2, game->boss.y + BOSS_H / 2);
-                        // Niveau suivant immédiat
-                        level_up(game);
-                    }
-                    continue; // Balle détruite, on passe à la suivante
-                }
-
-                // Contre ALIENS
-                if (!game->boss.active)
+                game->player.shield = false;
+                int row = aliens->bottom_row;
+                for (int c = 0; c < FORMATION_COLS; c++)
                 {
-                    for (int j = 0; j < MAX_ALIENS; j++)
-                    {
-                        Entity *alien = &game->aliens[j];
-                        if (alien->active && check_collision(b, alien))
-                        {
-                            alien->active = false;
-                            b->active = false;
-                            spawn_explosion(game, alien->x, alien->y);
-                            game->score += 100;
-                            if ((rand() % 100) < 5)
-                                init_items(game, alien->x + alien->width / 2.0f, alien->y + alien->height / 2.0f);
-                            break;
-                        }
-                    }
+                    int i = row * FORMATION_COLS + c;
+                    if (!pool_test(aliens->alive, i))
+                        continue;
+                    spawn_explosion(game, formation_alien_x(aliens, i), formation_alien_y(aliens, i));
+                    formation_kill(aliens, i);
                 }
             }
-
-            // TIR ENNEMIS (Alien ou Boss)
-            if (b->type == ENTITY_BULLET_ALIEN || b->type == ENTITY_BULLET_BOSS)
+            else
             {
-                Entity *player = &game->player;
-                if (player->active && check_collision(b, player))
-                {
-                    if (player->shield)
-                    {
-                        player->shield = false;
-                        spawn_explosion(game, player->x, player->y);
-                        b->active = false;
-                    }
-                    else
-                    {
-                        player->active = false;
-                        spawn_explosion(game, player->x, player->y);
-                        b->active = false;
-                        game->lives -= 1;
-                        if (game->lives <= 0)
-                        {
-                            game->game_over = true;
-                            if (game->score > game->high_score)
-                                game->high_score = game->score;
-                        }
-                        else
-                        {
-                            game->player.x = (GAME_WIDTH - PLAYER_W) / 2.0f;
-                            game->player.y = (GAME_HEIGHT - PLAYER_H - 10);
-                            game->player.active = true;
-                            game->respawn_timer = RESPAWN_DELAY;
-                        }
-                    }
-                }
+                game->game_over = true;
+                if (game->score > game->high_score)
+                    game->high_score = game->score;
             }
         }
     }
 
-    // Mise à jour explosions
-    for (int i = 0; i < EXPLOSION_MAX; i++)
-    {
-        if (game->explosions[i].active)
-        {
-            game->explosions[i].dx -= delta_time;
-            if (game->explosions[i].dx <= 0)
-                game->explosions[i].active = false;
-        }
-    }
-
-    // --- D. ITEMS ---
-    for (int i = 0; i < ITEMS_MAX; i++)
-    {
-        Entity *it = &game->items[i];
-        if (!it->active)
-            continue;
-        it->y += it->dy * delta_time;
-        if (it->y > GAME_HEIGHT)
-        {
-            it->active = false;
-            continue;
-        }
-
-        if (game->player.active && check_collision(it, &game->player))
-        {
-            game->player.shield = true;
-            game->score += 50;
-            it->active = false;
-            if (cb_play_item)
-                cb_play_item();
-        }
-    }
+    TRACE_END("aliens_boss");
+
+    // --- C. DÉPLACEMENT DES BALLES ET ITEMS ---
+    // Tout le pool est intégré d'un bloc (kernels.c) : les slots libres avancent
+    // aussi mais ne sont jamais lus, seul le masque de retrait est filtré par live.
+    // Les tirs sortis du terrain ne sont retirés qu'après les collisions : leur
+    // segment du tick a pu traverser une cible avant de quitter l'écran.
+    // Le kernel n'écrit que POOL_WORDS(n) mots : le reste des masques,
+    // lu par slot_release_mask, doit partir de zéro.
+    TRACE_BEGIN("bullets");
+    uint64_t bullets_out[SLOT_POOL_WORDS] = {0};
+    BulletPool *bullets = &game->bullets;
+    kernel_integrate_y(bullets->y, bullets->dy, MAX_BULLETS, delta_time, 0.0f, GAME_HEIGHT, bullets_out);
+    TRACE_END("bullets");
+
+    TRACE_BEGIN("items");
+    uint64_t retire[SLOT_POOL_WORDS] = {0};
+    ItemPool *items = &game->items;
+    kernel_integrate_y(items->y, items->dy, ITEMS_MAX, delta_time, -INFINITY, GAME_HEIGHT, retire);
+    slot_release_mask(&items->slots, retire);
+    TRACE_END("items");
+
+    // --- D. COLLISIONS (via la grille, tirs balayés sur le tick) ---
+    TRACE_BEGIN("collisions");
+    grid_build(game, delta_time);
+    collide_player_bullets(game, delta_time);
+    collide_player(game, delta_time);
+    slot_release_mask(&bullets->slots, bullets_out);
+    TRACE_END("collisions");
 
     // --- E. LEVEL CHECK (Seulement si pas de boss actif) ---
     // Si on est dans un niveau normal (pas multiple de 3) et qu'il n'y a plus d'aliens
-    if (!game->boss.active && (game->level % 3 != 0))
+    TRACE_BEGIN("level_check");
+    if (!game->boss.active && (game->level % 3 != 0) && game->aliens.alive_count == 0)
     {
-        int alive_count = 0;
-        for (int i = 0; i < MAX_ALIENS; i++)
-            if (game->aliens[i].active)
-                alive_count++;
-
-        if (alive_count == 0)
-        {
-            level_up(game);
-        }
+        level_up(game);
     }
+    TRACE_END("level_check");
 }
 
 // Déplace le jouer ()
@@ -507,31 +836,118 @@ void model_move_player(GameModel *game, float dx, float dy)
 // Tire une balle (depuis le joueur ou un alien)
 void model_fire_bullet(GameModel *game, float x, float y, EntityType type)
 {
-    for (int i = 0; i < MAX_BULLETS; i++)
+    BulletPool *bullets = &game->bullets;
+    int i = slot_acquire(&bullets->slots);
+    if (i < 0)
+        return;
+    bullets->type[i] = (uint8_t)type;
+    bullets->x[i] = x;
+    bullets->y[i] = y;
+
+    if (type == ENTITY_BULLET_PLAYER)
+    {
+        bullets->dy[i] = -BULLET_SPEED;
+    }
+    else
+    {
+        // Aliens et Boss tirent vers le bas
+        // La balle du boss est un peu plus rapide
+        float speed = (type == ENTITY_BULLET_BOSS) ? BULLET_SPEED * 1.5f : BULLET_SPEED;
+        bullets->dy[i] = speed * game->alien_speed_multiplier;
+    }
+    emit_event(game, MODEL_EVENT_SHOT, type, x, y);
+}
+
+// Minuteurs échus à la fin du tick (dans l'ordre où ils ont été posés)
+static void run_timers(GameModel *game)
+{
+    uint8_t kind;
+    uint16_t arg;
+    timer_wheel_advance(&game->timers, game->tick);
+    while (timer_pop(&game->timers, &kind, &arg))
     {
-        if (!game->bullets[i].active)
+        switch ((TimerKind)kind)
         {
-            game->bullets[i].active = true;
-            game->bullets[i].type = type;
-            game->bullets[i].x = x;
-            game->bullets[i].y = y;
-            game->bullets[i].width = BULLET_W;
-            game->bullets[i].height = BULLET_H;
-
-            if (type == ENTITY_BULLET_PLAYER)
-            {
-                if (cb_play_shoot)
-                    cb_play_shoot();
-                game->bullets[i].dy = -BULLET_SPEED;
-            }
-            else
-            {
-                // Aliens et Boss tirent vers le bas
-                // La balle du boss est un peu plus rapide
-                float speed = (type == ENTITY_BULLET_BOSS) ? BULLET_SPEED * 1.5f : BULLET_SPEED;
-                game->bullets[i].dy = speed * game->alien_speed_multiplier;
-            }
+        case TIMER_EXPLOSION_END:
+            slot_release(&game->explosions.slots, arg);
+            break;
+        case TIMER_PLAYER_RESPAWN:
+            game->player.x = (GAME_WIDTH - PLAYER_W) / 2.0f;
+            game->player.y = (GAME_HEIGHT - PLAYER_H - 10);
+            game->player.active = true;
+            break;
+        case TIMER_FIRE_READY:
+            game->fire_ready = true;
             break;
         }
     }
-}
\ No newline at end of file
+}
+
+// Un tick fixe de simulation
+void model_step(GameModel *game, ButtonMask held)
+{
+    // Deux directions opposées tenues s'annulent
+    float dx = (float)(((held & BTN_MASK(BTN_RIGHT)) != 0) - ((held & BTN_MASK(BTN_LEFT)) != 0));
+    float dy = (float)(((held & BTN_MASK(BTN_DOWN)) != 0) - ((held & BTN_MASK(BTN_UP)) != 0));
+    model_move_player(game, dx, dy);
+
+    if ((held & BTN_MASK(BTN_FIRE)) && game->fire_ready && game->player.active)
+    {
+        float x = game->player.x + (game->player.width / 2);
+        float y = game->player.y;
+        model_fire_bullet(game, x, y, ENTITY_BULLET_PLAYER);
+        game->fire_ready = false;
+        timer_add(&game->timers, TIMER_TICKS(PLAYER_FIRE_COOLDOWN, MODEL_TICK_HZ), TIMER_FIRE_READY, 0);
+    }
+
+    TRACE_BEGIN("model_update");
+    model_update(game, MODEL_TICK_DT);
+    TRACE_END("model_update");
+    game->tick++;
+    // Les explosions (et les autres échéances) expirent ici
+    TRACE_BEGIN("timers");
+    run_timers(game);
+    TRACE_END("timers");
+}
+
+static inline float lerpf(float a, float b, float t)
+{
+    return a + (b - a) * t;
+}
+
+// Un slot n'est interpolé que s'il contient la même entité aux deux ticks
+// (même numéro d'acquisition dans le SlotPool)
+static inline bool same_slot(const SlotPool *a, const SlotPool *b, int i)
+{
+    return pool_test(a->live, i) && a->stamp[i] == b->stamp[i];
+}
+
+void model_interpolate(const GameModel *prev, const GameModel *cur, float alpha, GameModel *out)
+{
+    *out = *cur;
+
+    // Changement de niveau ou restart : rien de commun entre les deux états
+    if (prev->level != cur->level || prev->tick + 1 != cur->tick)
+        return;
+
+    if (prev->player.active && cur->player.active)
+    {
+        out->player.x = lerpf(prev->player.x, cur->player.x, alpha);
+        out->player.y = lerpf(prev->player.y, cur->player.y, alpha);
+    }
+    if (prev->boss.active && cur->boss.active)
+        out->boss.x = lerpf(prev->boss.x, cur->boss.x, alpha);
+
+    out->aliens.origin_x = lerpf(prev->aliens.origin_x, cur->aliens.origin_x, alpha);
+    out->aliens.origin_y = lerpf(prev->aliens.origin_y, cur->aliens.origin_y, alpha);
+
+    const SlotPool *bs = &cur->bullets.slots;
+    for (int i = slot_next(bs, 0); i >= 0; i = slot_next(bs, i + 1))
+        if (same_slot(&prev->bullets.slots, bs, i))
+            out->bullets.y[i] = lerpf(prev->bullets.y[i], cur->bullets.y[i], alpha);
+
+    const SlotPool *is = &cur->items.slots;
+    for (int i = slot_next(is, 0); i >= 0; i = slot_next(is, i + 1))
+        if (same_slot(&prev->items.slots, is, i))
+            out->items.y[i] = lerpf(prev->items.y[i], cur->items.y[i], alpha);
+}
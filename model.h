@@ -4,12 +4,29 @@
 //
 //  Created by Cakir on 24/12/2025.
 //
+#ifndef MODEL_H
+#define MODEL_H
+
 #define GAME_WIDTH 1280
 #define GAME_HEIGHT 800
 #include <stdbool.h>
+#include <stdint.h>
+#include "pool.h"
+#include "rng.h"
+#include "timer.h"
+#include "controller.h"
 #define PLAYER_SPEED 7000.0f
 #define ALIEN_SPEED 800.f
 #define BULLET_SPEED 4000.0f
+#define PLAYER_FIRE_COOLDOWN 0.01f
+
+// PAS DE SIMULATION FIXE
+// La simulation avance toujours par ticks de MODEL_TICK_DT, quel que soit le
+// framerate de la vue. La boucle de jeu accumule le temps réel et joue de 0 à
+// MODEL_MAX_TICKS_PER_FRAME ticks par image (au-delà, le retard est abandonné).
+#define MODEL_TICK_HZ 120
+#define MODEL_TICK_DT (1.0f / MODEL_TICK_HZ)
+#define MODEL_MAX_TICKS_PER_FRAME 8
 
 // CONFIGURATION DU BOSS
 #define BOSS_W 180
@@ -17,13 +34,23 @@
 #define BOSS_HP_BASE 50
 #define BOSS_SPEED 600.0f
 
-#define MAX_ALIENS 55 // 5 rangeesde 11 aliens
+#define MAX_ALIENS 55 // 5 rangeesde 11 aliens (FORMATION_ROWS * FORMATION_COLS)
 #define MAX_BULLETS 100
 
 #define EXPLOSION_MAX 20
 #define EXPLOSION_TIME 0.2f
 #define ITEMS_MAX 10
 
+// Dimensions par type d'entité (hitbox logique, communes à tout le pool)
+#define PLAYER_W 90
+#define PLAYER_H 100
+#define ALIEN_W 40
+#define ALIEN_H 50
+#define BULLET_W 10
+#define BULLET_H 38
+#define EXPLOSION_SIZE 59
+#define ITEMS_SIZE 59
+
 typedef enum
 {
     ENTITY_PLAYER,
@@ -47,14 +74,216 @@ typedef struct
     bool shield; // bouclier actif pour le joueur/items
 } Entity;
 
+// --- POOLS D'ENTITÉS (structure de tableaux) ---
+// Chaque pool range ses champs dans des tableaux séparés pour que les boucles
+// de model_update ne lisent que ce dont elles ont besoin. Les slots vivants
+// sont gérés par un SlotPool (pool.h) : masque de bits compact, acquisition
+// et libération en O(1), compteurs exacts.
+
+// --- FORMATION D'ALIENS ---
+// La vague se déplace en bloc : on ne stocke qu'une origine, un masque des
+// aliens vivants (index = rangée * FORMATION_COLS + colonne) et les colonnes
+// vivantes extrêmes. La position d'un alien est origine + décalage fixe.
+// Les compteurs par colonne / rangée sont tenus à jour à chaque mort, ce qui
+// rend "vague terminée" et "la vague a atteint le joueur" en O(1).
+
+#define FORMATION_ROWS 5
+#define FORMATION_COLS 11
+#define FORMATION_START_X 100.0f
+#define FORMATION_START_Y 50.0f
+#define FORMATION_PITCH_X (ALIEN_W + 28) // largeur + espacement horizontal
+#define FORMATION_PITCH_Y (ALIEN_H + 22) // hauteur + espacement vertical
+
+typedef struct
+{
+    float origin_x, origin_y; // coin haut-gauche de la cellule (0, 0)
+    int left_col, right_col;  // colonnes vivantes extrêmes (-1 si vague vide)
+    int bottom_row;           // rangée vivante la plus basse (-1 si vague vide)
+    int alive_count;
+    uint8_t col_count[FORMATION_COLS]; // aliens vivants par colonne
+    uint8_t row_count[FORMATION_ROWS]; // aliens vivants par rangée
+    // Tireurs : l'alien vivant le plus bas de chaque colonne (rangée, -1 si
+    // colonne vide) et la liste des colonnes non vides, pour tirer au hasard
+    // uniformément parmi elles en O(1)
+    int8_t col_bottom[FORMATION_COLS];
+    int8_t live_cols[FORMATION_COLS];
+    int8_t live_col_pos[FORMATION_COLS]; // position de la colonne dans live_cols
+    int live_col_count;
+    uint64_t alive[POOL_WORDS(MAX_ALIENS)];
+} AlienFormation;
+
+static inline float formation_alien_x(const AlienFormation *f, int i)
+{
+    return f->origin_x + (float)((i % FORMATION_COLS) * FORMATION_PITCH_X);
+}
+
+static inline float formation_alien_y(const AlienFormation *f, int i)
+{
+    return f->origin_y + (float)((i / FORMATION_COLS) * FORMATION_PITCH_Y);
+}
+
+typedef struct
+{
+    float x[MAX_BULLETS];
+    float y[MAX_BULLETS];
+    float dy[MAX_BULLETS];
+    uint8_t type[MAX_BULLETS]; // EntityType (BULLET_PLAYER / ALIEN / BOSS)
+    SlotPool slots;            // pool plein : le tir est refusé
+} BulletPool;
+
+typedef struct
+{
+    float x[EXPLOSION_MAX];
+    float y[EXPLOSION_MAX];
+    int16_t timer[EXPLOSION_MAX]; // minuteur de disparition (GameModel.timers)
+    SlotPool slots;               // pool plein : la plus ancienne explosion est recyclée
+} ExplosionPool;
+
+typedef struct
+{
+    float x[ITEMS_MAX];
+    float y[ITEMS_MAX];
+    float dy[ITEMS_MAX];
+    SlotPool slots; // pool plein : le drop est refusé
+} ItemPool;
+
+// --- BROADPHASE : GRILLE UNIFORME ---
+// Le terrain 1280x800 est découpé en cellules de GRID_CELL_SIZE pixels.
+// Chaque tick, boss, items et tirs ennemis y sont rangés (tri par comptage),
+// puis chaque tir du joueur / le joueur ne teste que les entités des
+// cellules qu'il recouvre. Les aliens n'y sont pas : la formation est une
+// grille régulière, un tir y trouve sa cellule par simple calcul.
+
+#define GRID_CELL_SIZE 64
+#define GRID_COLS ((GAME_WIDTH + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE)
+#define GRID_ROWS ((GAME_HEIGHT + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE)
+#define GRID_CELLS (GRID_COLS * GRID_ROWS)
+
+// Nombre max de cellules couvertes par une boîte de taille s (borne haute).
+// Un tir est rangé avec tout le segment parcouru pendant le tick : sa
+// hauteur n'est bornée que par celle du terrain.
+#define GRID_SPAN(s) ((s) / GRID_CELL_SIZE + 2)
+#define GRID_MAX_ENTRIES (GRID_SPAN(BOSS_W) * GRID_SPAN(BOSS_H) +                      \
+                          ITEMS_MAX * GRID_SPAN(ITEMS_SIZE) * GRID_SPAN(ITEMS_SIZE) + \
+                          MAX_BULLETS * GRID_SPAN(BULLET_W) * GRID_ROWS)
+
+// Une entrée = type d'entité (4 bits de poids fort) + index dans son pool
+typedef enum
+{
+    GRID_REF_BOSS,
+    GRID_REF_ITEM,
+    GRID_REF_ENEMY_BULLET
+} GridRefKind;
+
+#define GRID_REF_SHIFT 12
+#define GRID_REF(kind, idx) ((uint16_t)(((kind) << GRID_REF_SHIFT) | (idx)))
+#define GRID_REF_KIND(ref) ((ref) >> GRID_REF_SHIFT)
+#define GRID_REF_INDEX(ref) ((ref) & ((1 << GRID_REF_SHIFT) - 1))
+
+typedef struct
+{
+    uint16_t cell_start[GRID_CELLS + 1]; // entries[cell_start[c] .. cell_start[c+1]) = cellule c
+    uint16_t entries[GRID_MAX_ENTRIES];
+} CollisionGrid;
+
+// Compteurs cumulés depuis model_init, pour mesurer l'élagage
+typedef struct
+{
+    uint64_t brute_force_pairs; // tests qu'aurait faits la version "tous contre tous"
+    uint64_t candidate_pairs;   // tests AABB réellement effectués après la grille
+    uint64_t confirmed_hits;    // collisions confirmées
+} CollisionStats;
+
+// --- ÉMETTEURS ---
+// Événements récurrents (tirs ennemis) cadencés en événements par seconde de
+// jeu, indépendamment du nombre de ticks ou d'images.
+
+// Cadences de référence : les anciens tirages par image à ~60 FPS (4 % et 5 %)
+#define ALIEN_FIRE_RATE 2.4f // tirs / seconde pour toute la vague
+#define BOSS_FIRE_RATE 3.0f  // tirs / seconde
+#define EMITTER_MAX_EVENTS 4 // au plus N événements par pas : travail borné si dt est grand
+
+typedef enum
+{
+    EMIT_FIXED,  // intervalle constant 1 / rate
+    EMIT_POISSON // intervalles exponentiels de moyenne 1 / rate (tirs "au hasard")
+} EmitterMode;
+
+typedef struct
+{
+    float rate; // événements par seconde, 0 = arrêté
+    float wait; // secondes avant le prochain événement
+    uint8_t mode;
+} Emitter;
+
+// --- MINUTEURS ---
+// Les échéances ponctuelles passent par la roue de minuteurs (timer.h) :
+// rien n'est décompté tick par tick. Nouveau type d'effet temporisé = une
+// valeur de plus ici et un cas dans le switch de model.c (run_timers).
+
+typedef enum
+{
+    TIMER_EXPLOSION_END, // arg = slot de l'explosion
+    TIMER_PLAYER_RESPAWN,
+    TIMER_FIRE_READY // fin du délai entre deux tirs du joueur
+} TimerKind;
+
+#if EXPLOSION_MAX + 2 > TIMER_MAX
+#error "TIMER_MAX trop petit pour les explosions et les minuteurs du joueur"
+#endif
+
+// Les masques des pools font SLOT_POOL_WORDS mots ; kernel_integrate_y y écrit POOL_WORDS(n) mots
+#if MAX_BULLETS > SLOT_POOL_MAX || ITEMS_MAX > SLOT_POOL_MAX || EXPLOSION_MAX > SLOT_POOL_MAX
+#error "SLOT_POOL_MAX trop petit pour MAX_BULLETS, ITEMS_MAX ou EXPLOSION_MAX"
+#endif
+
+typedef enum
+{
+    BOSS_APPROACH, // entre par la droite jusqu'au centre, sans tirer
+    BOSS_COMBAT    // rebondit sur les bords et tire
+} BossPhase;
+
+// --- ÉVÉNEMENTS MODÈLE -> VUE ---
+// Le modèle ne joue aucun son et n'écrit rien : il note ce qui s'est passé
+// dans une file circulaire que main vide une fois par image pour la vue
+// (sons, messages), qui peut regrouper les doublons d'une même image.
+
+typedef enum
+{
+    MODEL_EVENT_SHOT,       // arg = EntityType de la balle
+    MODEL_EVENT_HIT,        // arg = EntityType de la cible touchée (joueur, alien, boss)
+    MODEL_EVENT_EXPLOSION,
+    MODEL_EVENT_PICKUP,     // item ramassé
+    MODEL_EVENT_LEVEL_UP,   // arg = nouveau niveau
+    MODEL_EVENT_BOSS_PHASE, // arg = BossPhase
+    MODEL_EVENT_TYPES
+} ModelEventType;
+
+typedef struct
+{
+    uint8_t type; // ModelEventType
+    int32_t arg;
+    uint32_t tick;
+    float x, y;
+} ModelEvent;
+
+#define MODEL_EVENT_CAPACITY 256 // puissance de 2
+
+typedef struct
+{
+    ModelEvent items[MODEL_EVENT_CAPACITY];
+    uint32_t head, tail; // écriture / lecture, indices libres (masqués à l'accès)
+    uint32_t dropped;    // événements perdus file pleine
+} ModelEventQueue;
+
 typedef struct
 {
     Entity player;
     Entity boss; // L'entité du Boss
-    Entity aliens[MAX_ALIENS];
-    Entity bullets[MAX_BULLETS];
-    Entity explosions[EXPLOSION_MAX];
-    Entity items[ITEMS_MAX];
+    AlienFormation aliens;
+    BulletPool bullets;
+    ExplosionPool explosions;
+    ItemPool items;
     int score;
     int lives;
     int level;
@@ -63,21 +292,39 @@ typedef struct
     // Pour gérer le mouvement de groupe des aliens
     float alien_move_timer;
     int alien_direction;
-    float respawn_timer;
+    uint8_t boss_phase; // BossPhase
+    Emitter alien_fire;
+    Emitter boss_fire;
+    bool fire_ready;   // faux pendant PLAYER_FIRE_COOLDOWN après un tir
+    uint32_t tick;     // nombre de ticks simulés depuis model_init
+    uint64_t seed;     // graine passée à model_init
+    Rng rng;           // seule source d'aléatoire de la simulation
+    TimerWheel timers; // échéances de la partie, en ticks
     int menu_mode;      // 0 = none, 1 = start menu, 2 = settings, 3 = highscores, 4 = paused
     int menu_selection; // index sélectionné dans le menu
     int high_score;     // meilleur score enregistré (simple mémoire en RAM)
     bool paused;
     float alien_speed_multiplier; // multiplie ALIEN_SPEED pour augmenter la difficulté
 
+    CollisionStats collision_stats;
+    CollisionGrid grid;     // reconstruite à chaque model_update
+    ModelEventQueue events; // vidée par la boucle d'affichage (hors snapshot)
+
 } GameModel;
 
-// Initialise toutes les variables (positions de départ)
-void model_init(GameModel *game);
+// Initialise toutes les variables (positions de départ).
+// Deux parties lancées avec la même graine et les mêmes entrées sont identiques.
+void model_init(GameModel *game, uint64_t seed);
 
 // Met à jour la position de tout le monde en fonction du temps écoulé (dt)
 void model_update(GameModel *game, float delta_time);
 
+// Un tick fixe : applique les boutons tenus (déplacement et tir cumulables) puis model_update(MODEL_TICK_DT)
+void model_step(GameModel *game, ButtonMask held);
+
+// État à afficher entre deux ticks : out = prev + (cur - prev) * alpha, alpha dans [0, 1]
+void model_interpolate(const GameModel *prev, const GameModel *cur, float alpha, GameModel *out);
+
 // Déplace le joueur (-1 pour gauche, +1 pour droite, 0 pour stop)
 void model_move_player(GameModel *game, float dx, float dy);
 
@@ -86,8 +333,50 @@ void model_fire_bullet(GameModel *game, float x, float y, EntityType type);
 void alien_tire(GameModel *game);
 void spawn_explosion(GameModel *game, float x, float y);
 
-// Audio callback registration (model triggers events; view registers handlers)
-typedef void (*AudioCallback)(void);
 void init_items(GameModel *game, float x, float y);
-void model_set_audio_callbacks(void (*on_item)(void), void (*on_explosion)(void), void (*on_shoot)(void));
-void model_set_audio_callbacks(AudioCallback on_item, AudioCallback on_explosion, AudioCallback on_shoot);
\ No newline at end of file
+
+// Retire le plus ancien événement en attente ; false si la file est vide
+bool model_poll_event(GameModel *game, ModelEvent *out);
+
+// --- ACCESSEURS POUR LES VUES ---
+// Reconstituent une Entity à partir des pools. Renvoient false si le slot est libre.
+
+static inline bool model_get_alien(const GameModel *game, int i, Entity *out)
+{
+    if (!pool_test(game->aliens.alive, i))
+        return false;
+    *out = (Entity){formation_alien_x(&game->aliens, i), formation_alien_y(&game->aliens, i), 0, 0, ALIEN_W, ALIEN_H,
+                    1, true, ENTITY_ALIEN, false};
+    return true;
+}
+
+static inline bool model_get_bullet(const GameModel *game, int i, Entity *out)
+{
+    if (!pool_test(game->bullets.slots.live, i))
+        return false;
+    *out = (Entity){game->bullets.x[i], game->bullets.y[i], 0, game->bullets.dy[i], BULLET_W, BULLET_H, 1, true,
+                    (EntityType)game->bullets.type[i], false};
+    return true;
+}
+
+static inline bool model_get_explosion(const GameModel *game, int i, Entity *out)
+{
+    if (!pool_test(game->explosions.slots.live, i))
+        return false;
+    // dx garde sa signification historique : temps restant de l'explosion
+    float ttl = (float)timer_remaining(&game->timers, game->explosions.timer[i]) * MODEL_TICK_DT;
+    *out = (Entity){game->explosions.x[i], game->explosions.y[i], ttl, 0, EXPLOSION_SIZE,
+                    EXPLOSION_SIZE, 1, true, ENTITY_EXPLOSION, false};
+    return true;
+}
+
+static inline bool model_get_item(const GameModel *game, int i, Entity *out)
+{
+    if (!pool_test(game->items.slots.live, i))
+        return false;
+    *out = (Entity){game->items.x[i], game->items.y[i], 0, game->items.dy[i], ITEMS_SIZE, ITEMS_SIZE, 1, true,
+                    ENTITY_ITEMS, false};
+    return true;
+}
+
+#endif // MODEL_H
\ No newline at end of file
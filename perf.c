@@ -0,0 +1,149 @@
+//
+//  perf.c
+//
+
+#define _POSIX_C_SOURCE 199309L
+#include "perf.h"
+
+#if PERF_ENABLED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct
+{
+    uint32_t phase_ns[PERF_PHASES];
+    uint32_t frame_ns; // intervalle entre deux fins d'image, sommeil compris
+    uint32_t draw_calls;
+    uint32_t output_bytes;
+} PerfFrame;
+
+static PerfFrame frames[PERF_WINDOW];
+static int frame_head = 0;
+static int frame_count = 0;
+static PerfFrame current;
+static uint64_t last_frame_end = 0;
+
+static char overlay[PERF_LINES][PERF_LINE_LEN];
+static int overlay_count = 0;
+static uint64_t overlay_time = 0;
+
+uint64_t perf_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void perf_add(PerfPhase phase, uint64_t ns)
+{
+    current.phase_ns[phase] += (uint32_t)ns;
+}
+
+void perf_set_draw_calls(int calls)
+{
+    current.draw_calls = (uint32_t)calls;
+}
+
+void perf_set_output_bytes(long long bytes)
+{
+    current.output_bytes = (uint32_t)bytes;
+}
+
+void perf_frame_end(void)
+{
+    uint64_t now = perf_now_ns();
+    if (last_frame_end)
+    {
+        current.frame_ns = (uint32_t)(now - last_frame_end);
+        frames[frame_head] = current;
+        frame_head = (frame_head + 1) % PERF_WINDOW;
+        if (frame_count < PERF_WINDOW)
+            frame_count++;
+    }
+    last_frame_end = now;
+    memset(&current, 0, sizeof(current));
+}
+
+void perf_frame_skip(void)
+{
+    last_frame_end = 0;
+    memset(&current, 0, sizeof(current));
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void format_lines(const GameModel *model)
+{
+    static const char *names[PERF_PHASES] = {"input", "update", "render", "present"};
+    uint64_t sum[PERF_PHASES] = {0};
+    uint64_t calls = 0, bytes = 0;
+    uint32_t sorted[PERF_WINDOW];
+    for (int i = 0; i < frame_count; i++)
+    {
+        for (int p = 0; p < PERF_PHASES; p++)
+            sum[p] += frames[i].phase_ns[p];
+        calls += frames[i].draw_calls;
+        bytes += frames[i].output_bytes;
+        sorted[i] = frames[i].frame_ns;
+    }
+    qsort(sorted, (size_t)frame_count, sizeof(sorted[0]), cmp_u32);
+
+    int n = 0;
+    snprintf(overlay[n++], PERF_LINE_LEN, "PERF (%d images)", frame_count);
+    int count = frame_count ? frame_count : 1;
+    for (int p = 0; p < PERF_PHASES; p++)
+    {
+        // Le rendu est affiché sans la présentation, mesurée à part
+        uint64_t ns = sum[p] - (p == PERF_RENDER ? sum[PERF_PRESENT] : 0);
+        snprintf(overlay[n++], PERF_LINE_LEN, "%-8s %6.2f ms", names[p], ns / 1e6 / count);
+    }
+    if (frame_count)
+        snprintf(overlay[n++], PERF_LINE_LEN, "image p50 %.1f p95 %.1f p99 %.1f",
+                 sorted[frame_count / 2] / 1e6, sorted[frame_count * 95 / 100] / 1e6,
+                 sorted[frame_count * 99 / 100] / 1e6);
+    if (bytes)
+        snprintf(overlay[n++], PERF_LINE_LEN, "sortie   %6.0f octets", (double)bytes / count);
+    else
+        snprintf(overlay[n++], PERF_LINE_LEN, "dessin   %6.1f appels", (double)calls / count);
+
+    snprintf(overlay[n++], PERF_LINE_LEN, "aliens   %3d/%d", model->aliens.alive_count, MAX_ALIENS);
+    const struct
+    {
+        const char *name;
+        const SlotPool *pool;
+    } pools[] = {
+        {"balles", &model->bullets.slots},
+        {"explos", &model->explosions.slots},
+        {"items", &model->items.slots},
+    };
+    for (size_t i = 0; i < sizeof(pools) / sizeof(pools[0]); i++)
+    {
+        // Pool plein : spawns refusés ou plus anciens recyclés, selon sa politique
+        const SlotPool *p = pools[i].pool;
+        bool reject = p->policy == POOL_FULL_REJECT;
+        snprintf(overlay[n++], PERF_LINE_LEN, "%-8s %3d/%d max %d %s %u", pools[i].name, p->count, p->capacity,
+                 p->high_water, reject ? "refus" : "recycl", reject ? p->rejected : p->evicted);
+    }
+    overlay_count = n;
+}
+
+int perf_overlay_lines(const GameModel *model, char lines[PERF_LINES][PERF_LINE_LEN])
+{
+    uint64_t now = perf_now_ns();
+    if (overlay_count == 0 || now - overlay_time >= PERF_REFRESH_NS)
+    {
+        format_lines(model);
+        overlay_time = now;
+    }
+    memcpy(lines, overlay, sizeof(overlay));
+    return overlay_count;
+}
+
+#endif // PERF_ENABLED
@@ -0,0 +1,76 @@
+//
+//  perf.h
+//
+//  Instrumentation légère de la boucle de jeu, pour l'overlay de performance
+//  (F3 en SDL, F3 ou 'o' en ncurses) : temps des phases (entrées, mise à jour
+//  du modèle, rendu, présentation), percentiles du temps d'image sur une
+//  fenêtre glissante, appels de dessin (SDL) ou octets écrits (ncurses),
+//  entités vivantes et maximums atteints par pool.
+//
+//  Compilé avec -DPERF_ENABLED=0, toutes les macros deviennent vides et
+//  l'overlay n'a plus rien à afficher : aucun coût dans la boucle.
+//
+
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdint.h>
+#include "model.h"
+
+#ifndef PERF_ENABLED
+#define PERF_ENABLED 1
+#endif
+
+typedef enum
+{
+    PERF_INPUT,   // view.get_input
+    PERF_UPDATE,  // ticks de model_step de l'image
+    PERF_RENDER,  // événements + interpolation + view.render (présentation comprise)
+    PERF_PRESENT, // SDL_RenderPresent / refresh, mesuré par la vue
+    PERF_PHASES
+} PerfPhase;
+
+#define PERF_WINDOW 240         // images gardées pour les moyennes et percentiles (~4 s)
+#define PERF_REFRESH_NS 250000000ull // le texte de l'overlay change au plus 4 fois par seconde
+#define PERF_LINES 12
+#define PERF_LINE_LEN 48
+
+#if PERF_ENABLED
+
+uint64_t perf_now_ns(void);
+void perf_add(PerfPhase phase, uint64_t ns);
+void perf_set_draw_calls(int calls);
+void perf_set_output_bytes(long long bytes);
+void perf_frame_end(void);
+void perf_frame_skip(void);
+
+// Texte de l'overlay pour l'état affiché ; renvoie le nombre de lignes
+int perf_overlay_lines(const GameModel *model, char lines[PERF_LINES][PERF_LINE_LEN]);
+
+#define PERF_BEGIN(phase) uint64_t perf_t0_##phase = perf_now_ns()
+#define PERF_END(phase) perf_add(phase, perf_now_ns() - perf_t0_##phase)
+#define PERF_DRAW_CALLS(calls) perf_set_draw_calls(calls)
+#define PERF_OUTPUT_BYTES(bytes) perf_set_output_bytes(bytes) // octets envoyés au terminal
+#define PERF_FRAME_END() perf_frame_end()
+// L'image en cours ne compte pas (pause, menu, redémarrage)
+#define PERF_FRAME_SKIP() perf_frame_skip()
+
+#else
+
+#define PERF_BEGIN(phase) ((void)0)
+#define PERF_END(phase) ((void)0)
+#define PERF_DRAW_CALLS(calls) ((void)0)
+#define PERF_OUTPUT_BYTES(bytes) ((void)0)
+#define PERF_FRAME_END() ((void)0)
+#define PERF_FRAME_SKIP() ((void)0)
+
+static inline int perf_overlay_lines(const GameModel *model, char lines[PERF_LINES][PERF_LINE_LEN])
+{
+    (void)model;
+    (void)lines;
+    return 0;
+}
+
+#endif // PERF_ENABLED
+
+#endif // PERF_H
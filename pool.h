@@ -0,0 +1,146 @@
+//
+//  pool.h
+//
+//  Allocation de slots en O(1) pour les pools d'entités (balles, explosions, items).
+//  Les slots vivants sont un masque de bits : acquérir = chercher le premier
+//  bit à zéro, libérer = effacer le bit, parcourir = sauter de bit en bit.
+//
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define POOL_WORDS(n) (((n) + 63) / 64)
+
+static inline bool pool_test(const uint64_t *mask, int i)
+{
+    return (mask[i >> 6] >> (i & 63)) & 1u;
+}
+
+static inline void pool_set(uint64_t *mask, int i)
+{
+    mask[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+static inline void pool_clear(uint64_t *mask, int i)
+{
+    mask[i >> 6] &= ~((uint64_t)1 << (i & 63));
+}
+
+// Capacité max d'un SlotPool (le plus gros pool du jeu : les balles)
+#define SLOT_POOL_MAX 128
+#define SLOT_POOL_WORDS POOL_WORDS(SLOT_POOL_MAX)
+
+// Que faire quand on demande un slot à un pool plein
+typedef enum
+{
+    POOL_FULL_REJECT,     // le spawn est refusé (compté dans "rejected")
+    POOL_FULL_DROP_OLDEST // le slot le plus ancien est recyclé (compté dans "evicted")
+} PoolFullPolicy;
+
+typedef struct
+{
+    uint64_t live[SLOT_POOL_WORDS];
+    uint32_t stamp[SLOT_POOL_MAX]; // ordre d'acquisition, pour DROP_OLDEST
+    uint32_t clock;
+    int capacity;
+    int count;      // slots vivants, exact
+    int high_water; // max de count depuis l'init
+    uint32_t rejected;
+    uint32_t evicted;
+    PoolFullPolicy policy;
+} SlotPool;
+
+static inline void slot_pool_init(SlotPool *p, int capacity, PoolFullPolicy policy)
+{
+    memset(p, 0, sizeof(*p));
+    p->capacity = capacity;
+    p->policy = policy;
+}
+
+// Libère tous les slots (les statistiques sont conservées)
+static inline void slot_pool_release_all(SlotPool *p)
+{
+    memset(p->live, 0, sizeof(p->live));
+    p->count = 0;
+}
+
+static inline void slot_release(SlotPool *p, int i)
+{
+    if (!pool_test(p->live, i))
+        return;
+    pool_clear(p->live, i);
+    p->count--;
+}
+
+// Libère d'un coup les slots dont le bit est à 1 dans mask (SLOT_POOL_WORDS mots),
+// par exemple le masque "à retirer" produit par les kernels d'intégration
+static inline void slot_release_mask(SlotPool *p, const uint64_t *mask)
+{
+    for (int w = 0; w < SLOT_POOL_WORDS; w++)
+    {
+        uint64_t dead = p->live[w] & mask[w];
+        p->live[w] &= ~dead;
+        p->count -= __builtin_popcountll(dead);
+    }
+}
+
+// Premier slot vivant d'index >= from, ou -1.
+// Parcours : for (int i = slot_next(p, 0); i >= 0; i = slot_next(p, i + 1))
+static inline int slot_next(const SlotPool *p, int from)
+{
+    int w = from >> 6;
+    if (w >= SLOT_POOL_WORDS)
+        return -1;
+    uint64_t bits = p->live[w] & (~(uint64_t)0 << (from & 63));
+    while (!bits)
+    {
+        if (++w >= SLOT_POOL_WORDS)
+            return -1;
+        bits = p->live[w];
+    }
+    return (w << 6) + __builtin_ctzll(bits);
+}
+
+// Renvoie un slot libre (marqué vivant), ou -1 si le pool est plein et que
+// la politique est REJECT. En DROP_OLDEST, le slot recyclé est le plus ancien
+// (seul cas qui parcourt le pool).
+static inline int slot_acquire(SlotPool *p)
+{
+    int i = -1;
+    if (p->count < p->capacity)
+    {
+        for (int w = 0; w < POOL_WORDS(p->capacity); w++)
+        {
+            uint64_t free_bits = ~p->live[w];
+            if (free_bits)
+            {
+                i = (w << 6) + __builtin_ctzll(free_bits);
+                break;
+            }
+        }
+        pool_set(p->live, i);
+        if (++p->count > p->high_water)
+            p->high_water = p->count;
+    }
+    else if (p->policy == POOL_FULL_DROP_OLDEST && p->capacity > 0)
+    {
+        i = 0;
+        for (int j = 1; j < p->capacity; j++)
+            if (p->clock - p->stamp[j] > p->clock - p->stamp[i])
+                i = j;
+        p->evicted++;
+    }
+    else
+    {
+        p->rejected++;
+        return -1;
+    }
+    p->stamp[i] = p->clock++;
+    return i;
+}
+
+#endif // POOL_H
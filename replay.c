@@ -0,0 +1,242 @@
+//
+//  replay.c
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "replay.h"
+#include "model.h"
+
+static const char REPLAY_MAGIC[4] = {'S', 'I', 'R', 'P'};
+
+void replay_begin_recording(Replay *replay, uint64_t seed)
+{
+    replay_free(replay);
+    replay->seed = seed;
+}
+
+// Ajoute un tick : prolonge la dernière plage si l'entrée n'a pas changé
+void replay_record(Replay *replay, ButtonMask held)
+{
+    held &= BTN_GAMEPLAY_MASK; // le reste (pause, menus) n'agit pas sur model_step
+    replay->ticks++;
+    if (replay->run_count > 0)
+    {
+        ReplayRun *last = &replay->runs[replay->run_count - 1];
+        if (last->held == held && last->length < UINT32_MAX)
+        {
+            last->length++;
+            return;
+        }
+    }
+
+    if (replay->run_count == replay->run_capacity)
+    {
+        int capacity = replay->run_capacity ? replay->run_capacity * 2 : 256;
+        ReplayRun *runs = realloc(replay->runs, (size_t)capacity * sizeof(ReplayRun));
+        if (!runs)
+        {
+            fprintf(stderr, "⚠️ Replay : mémoire insuffisante, tick ignoré.\n");
+            replay->ticks--;
+            return;
+        }
+        replay->runs = runs;
+        replay->run_capacity = capacity;
+    }
+    replay->runs[replay->run_count++] = (ReplayRun){held, 1};
+}
+
+// --- Écriture / lecture little-endian ---
+
+static void put_u(FILE *f, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+        fputc((int)((v >> (8 * i)) & 0xFF), f);
+}
+
+static bool get_u(FILE *f, uint64_t *v, int bytes)
+{
+    *v = 0;
+    for (int i = 0; i < bytes; i++)
+    {
+        int c = fgetc(f);
+        if (c == EOF)
+            return false;
+        *v |= (uint64_t)c << (8 * i);
+    }
+    return true;
+}
+
+static void put_varint(FILE *f, uint32_t v)
+{
+    while (v >= 0x80)
+    {
+        fputc((int)((v & 0x7F) | 0x80), f);
+        v >>= 7;
+    }
+    fputc((int)v, f);
+}
+
+static bool get_varint(FILE *f, uint32_t *v)
+{
+    *v = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        int c = fgetc(f);
+        if (c == EOF)
+            return false;
+        *v |= (uint32_t)(c & 0x7F) << shift;
+        if (!(c & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool replay_save(Replay *replay, const char *path, int final_score)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+    {
+        fprintf(stderr, "⚠️ Erreur : Impossible d'écrire le replay %s\n", path);
+        return false;
+    }
+
+    replay->final_score = final_score;
+    fwrite(REPLAY_MAGIC, 1, sizeof(REPLAY_MAGIC), f);
+    put_u(f, REPLAY_VERSION, 1);
+    put_u(f, MODEL_TICK_HZ, 2);
+    put_u(f, replay->seed, 8);
+    put_u(f, replay->ticks, 4);
+    put_u(f, (uint32_t)replay->final_score, 4);
+    put_u(f, (uint32_t)replay->run_count, 4);
+    for (int i = 0; i < replay->run_count; i++)
+    {
+        put_varint(f, replay->runs[i].held);
+        put_varint(f, replay->runs[i].length);
+    }
+
+    bool ok = !ferror(f);
+    long size = ftell(f);
+    fclose(f);
+    if (ok)
+        printf("💾 Replay sauvegardé : %s (%u ticks, %d plages, %ld octets)\n", path, replay->ticks, replay->run_count, size);
+    return ok;
+}
+
+bool replay_load(Replay *replay, const char *path)
+{
+    replay_free(replay);
+
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        fprintf(stderr, "⚠️ Erreur : Replay introuvable %s\n", path);
+        return false;
+    }
+
+    char magic[4];
+    uint64_t version, hz, seed, ticks, score, count;
+    bool ok = fread(magic, 1, sizeof(magic), f) == sizeof(magic) && memcmp(magic, REPLAY_MAGIC, sizeof(magic)) == 0 &&
+              get_u(f, &version, 1) && (version == 1 || version == REPLAY_VERSION) &&
+              get_u(f, &hz, 2) && get_u(f, &seed, 8) && get_u(f, &ticks, 4) &&
+              get_u(f, &score, 4) && get_u(f, &count, 4);
+    if (ok && hz != MODEL_TICK_HZ)
+    {
+        fprintf(stderr, "⚠️ Replay enregistré à %u Hz, la simulation tourne à %d Hz.\n", (unsigned)hz, MODEL_TICK_HZ);
+        ok = false;
+    }
+
+    if (ok && count > 0)
+    {
+        replay->runs = malloc((size_t)count * sizeof(ReplayRun));
+        ok = replay->runs != NULL;
+        for (uint64_t i = 0; ok && i < count; i++)
+        {
+            uint32_t held;
+            if (version == 1) // un seul bouton par tick, BTN_NONE compris
+            {
+                int c = fgetc(f);
+                held = (c == EOF || c == BTN_NONE || c > BTN_DOWN) ? 0 : BTN_MASK(c);
+                ok = c != EOF;
+            }
+            else
+                ok = get_varint(f, &held);
+            ok = ok && get_varint(f, &replay->runs[i].length);
+            replay->runs[i].held = (ButtonMask)held & BTN_GAMEPLAY_MASK;
+        }
+        replay->run_count = replay->run_capacity = (int)count;
+    }
+    fclose(f);
+
+    if (!ok)
+    {
+        fprintf(stderr, "⚠️ Erreur : Replay invalide %s\n", path);
+        replay_free(replay);
+        return false;
+    }
+
+    replay->seed = seed;
+    replay->ticks = (uint32_t)ticks;
+    replay->final_score = (int32_t)(uint32_t)score;
+    replay_rewind(replay);
+    printf("📂 Replay chargé : %s (%u ticks, graine %llu)\n", path, replay->ticks, (unsigned long long)replay->seed);
+    return true;
+}
+
+void replay_rewind(Replay *replay)
+{
+    replay->play_run = 0;
+    replay->play_pos = 0;
+}
+
+bool replay_next(Replay *replay, ButtonMask *held)
+{
+    while (replay->play_run < replay->run_count && replay->play_pos >= replay->runs[replay->play_run].length)
+    {
+        replay->play_run++;
+        replay->play_pos = 0;
+    }
+    if (replay->play_run >= replay->run_count)
+        return false;
+
+    *held = replay->runs[replay->play_run].held;
+    replay->play_pos++;
+    return true;
+}
+
+// Place le curseur de relecture juste avant le tick `tick` (après un rembobinage)
+void replay_seek(Replay *replay, uint32_t tick)
+{
+    replay_rewind(replay);
+    while (replay->play_run < replay->run_count && tick >= replay->runs[replay->play_run].length)
+    {
+        tick -= replay->runs[replay->play_run].length;
+        replay->play_run++;
+    }
+    replay->play_pos = tick;
+}
+
+// Oublie les entrées enregistrées à partir du tick `tick` (la partie a été rembobinée)
+void replay_truncate(Replay *replay, uint32_t tick)
+{
+    if (tick >= replay->ticks)
+        return;
+    uint32_t kept = 0;
+    int run = 0;
+    while (run < replay->run_count && kept + replay->runs[run].length <= tick)
+        kept += replay->runs[run++].length;
+    if (run < replay->run_count && kept < tick)
+    {
+        replay->runs[run].length = tick - kept;
+        run++;
+    }
+    replay->run_count = run;
+    replay->ticks = tick;
+}
+
+void replay_free(Replay *replay)
+{
+    free(replay->runs);
+    memset(replay, 0, sizeof(*replay));
+}
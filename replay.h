@@ -0,0 +1,61 @@
+//
+//  replay.h
+//
+//  Enregistrement / relecture d'une partie : la graine de model_init plus
+//  l'entrée de chaque tick (model_step), compressée par plages (run-length)
+//  puisque la même touche est tenue pendant de nombreux ticks.
+//
+//  Format du fichier (little-endian) :
+//    "SIRP"  u8 version  u16 tick_hz  u64 seed  u32 ticks  i32 final_score  u32 nb_plages
+//    puis pour chaque plage : boutons tenus (ButtonMask) et longueur, en varint (LEB128)
+//  La version 1 stockait un seul KEY_BOUTONS (u8) par plage ; elle se relit
+//  toujours, convertie en masque au chargement.
+//
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "controller.h"
+
+#define REPLAY_VERSION 2
+
+typedef struct
+{
+    ButtonMask held; // boutons de jeu tenus (BTN_GAMEPLAY_MASK)
+    uint32_t length; // nombre de ticks consécutifs avec cette entrée
+} ReplayRun;
+
+// À initialiser à zéro (Replay r = {0};) avant le premier usage
+typedef struct
+{
+    uint64_t seed;
+    uint32_t ticks;      // nombre total de ticks enregistrés
+    int32_t final_score; // score en fin d'enregistrement (vérification à la relecture)
+    ReplayRun *runs;
+    int run_count;
+    int run_capacity;
+
+    // Curseur de relecture
+    int play_run;
+    uint32_t play_pos;
+} Replay;
+
+// Enregistrement
+void replay_begin_recording(Replay *replay, uint64_t seed);
+void replay_record(Replay *replay, ButtonMask held);
+bool replay_save(Replay *replay, const char *path, int final_score);
+
+// Relecture
+bool replay_load(Replay *replay, const char *path);
+void replay_rewind(Replay *replay);
+bool replay_next(Replay *replay, ButtonMask *held); // false quand l'enregistrement est terminé
+void replay_seek(Replay *replay, uint32_t tick);
+
+// Rembobinage pendant l'enregistrement : ne garde que les ticks [0, tick)
+void replay_truncate(Replay *replay, uint32_t tick);
+
+void replay_free(Replay *replay);
+
+#endif // REPLAY_H
@@ -0,0 +1,56 @@
+//
+//  rng.h
+//
+//  Générateur pseudo-aléatoire PCG32 (O'Neill) : 16 octets d'état, pas de
+//  verrou ni d'état global, reproductible à partir d'une graine. Chaque
+//  GameModel a le sien ; les vues utilisent leurs propres flux (streams) pour
+//  ne jamais perturber la séquence de la simulation.
+//
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Flux indépendants pour une même graine
+#define RNG_STREAM_MODEL 1u
+#define RNG_STREAM_STARS 2u
+#define RNG_STREAM_LAUNCHER 3u
+
+typedef struct
+{
+    uint64_t state;
+    uint64_t inc; // toujours impair : sélectionne le flux
+} Rng;
+
+static inline uint32_t rng_next(Rng *r)
+{
+    uint64_t old = r->state;
+    r->state = old * 6364136223846793005ULL + r->inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+static inline void rng_seed(Rng *r, uint64_t seed, uint64_t stream)
+{
+    r->state = 0u;
+    r->inc = (stream << 1u) | 1u;
+    rng_next(r);
+    r->state += seed;
+    rng_next(r);
+}
+
+// Entier dans [0, n) (multiplication au lieu d'un modulo)
+static inline uint32_t rng_range(Rng *r, uint32_t n)
+{
+    return (uint32_t)(((uint64_t)rng_next(r) * n) >> 32);
+}
+
+// Flottant dans [0, 1)
+static inline float rng_float(Rng *r)
+{
+    return (float)(rng_next(r) >> 8) * (1.0f / 16777216.0f);
+}
+
+#endif // RNG_H
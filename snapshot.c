@@ -0,0 +1,91 @@
+//
+//  snapshot.c
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "snapshot.h"
+
+void snapshot_restore(GameModel *game, const Snapshot *snap)
+{
+    int menu_mode = game->menu_mode;
+    int menu_selection = game->menu_selection;
+    int high_score = game->high_score;
+    bool paused = game->paused;
+
+    memcpy(game, snap->bytes, SNAPSHOT_SIZE);
+
+    game->menu_mode = menu_mode;
+    game->menu_selection = menu_selection;
+    game->high_score = high_score;
+    game->paused = paused;
+}
+
+bool rewind_init(RewindBuffer *rb, int seconds)
+{
+    memset(rb, 0, sizeof(*rb));
+    int capacity = seconds * MODEL_TICK_HZ;
+    if (capacity < 1)
+        capacity = 1;
+    rb->frames = malloc((size_t)capacity * sizeof(Snapshot));
+    if (!rb->frames)
+    {
+        fprintf(stderr, "⚠️ Rembobinage désactivé : mémoire insuffisante.\n");
+        return false;
+    }
+    rb->capacity = capacity;
+    return true;
+}
+
+void rewind_free(RewindBuffer *rb)
+{
+    free(rb->frames);
+    memset(rb, 0, sizeof(*rb));
+}
+
+void rewind_clear(RewindBuffer *rb)
+{
+    rb->head = 0;
+    rb->count = 0;
+    rb->cursor = 0;
+}
+
+void rewind_push(RewindBuffer *rb, const GameModel *game)
+{
+    if (!rb->frames)
+        return;
+    snapshot_save(game, &rb->frames[rb->head]);
+    rb->head = (rb->head + 1) % rb->capacity;
+    if (rb->count < rb->capacity)
+        rb->count++;
+}
+
+int rewind_step(RewindBuffer *rb, GameModel *game, int steps)
+{
+    if (rb->count == 0)
+        return 0;
+
+    int target = rb->cursor + steps;
+    if (target > rb->count - 1)
+        target = rb->count - 1;
+    if (target < 0)
+        target = 0;
+
+    int moved = target - rb->cursor;
+    if (moved == 0)
+        return 0;
+
+    rb->cursor = target;
+    int slot = ((rb->head - 1 - rb->cursor) % rb->capacity + rb->capacity) % rb->capacity;
+    snapshot_restore(game, &rb->frames[slot]);
+    return moved < 0 ? -moved : moved;
+}
+
+void rewind_commit(RewindBuffer *rb)
+{
+    if (!rb->frames)
+        return;
+    rb->count -= rb->cursor;
+    rb->head = ((rb->head - rb->cursor) % rb->capacity + rb->capacity) % rb->capacity;
+    rb->cursor = 0;
+}
@@ -0,0 +1,65 @@
+//
+//  snapshot.h
+//
+//  Sauvegarde / restauration de l'état complet d'une partie (positions,
+//  pools, timers, état du PRNG) et tampon circulaire de rembobinage.
+//
+//  Un snapshot est la copie brute des champs de GameModel qui précèdent
+//  `grid` : tout ce qui suit est recalculé à chaque tick et n'a pas besoin
+//  d'être sauvegardé. Le GameModel ne contient aucun pointeur, un memcpy
+//  suffit (~4.9 Ko roue de minuteurs comprise, quelques centaines de ns).
+//
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>
+#include <string.h>
+#include <stdbool.h>
+#include "model.h"
+
+#define SNAPSHOT_SIZE offsetof(GameModel, grid)
+
+typedef struct
+{
+    unsigned char bytes[SNAPSHOT_SIZE];
+} Snapshot;
+
+static inline void snapshot_save(const GameModel *game, Snapshot *out)
+{
+    memcpy(out->bytes, game, SNAPSHOT_SIZE);
+}
+
+// Restaure la simulation ; l'état des menus (menu_mode, sélection, high score,
+// pause) est celui de `game`, pas celui du snapshot.
+void snapshot_restore(GameModel *game, const Snapshot *snap);
+
+// --- REMBOBINAGE ---
+// Les derniers `capacity` ticks, le plus récent étant l'état courant de la
+// partie. Toute la mémoire est allouée par rewind_init : rewind_push ne fait
+// qu'une copie.
+
+typedef struct
+{
+    Snapshot *frames;
+    int capacity;
+    int head;   // slot du prochain rewind_push
+    int count;  // snapshots valides
+    int cursor; // ticks de recul par rapport au plus récent (0 = présent)
+} RewindBuffer;
+
+bool rewind_init(RewindBuffer *rb, int seconds);
+void rewind_free(RewindBuffer *rb);
+void rewind_clear(RewindBuffer *rb);
+
+// À appeler après chaque model_step (et après model_init)
+void rewind_push(RewindBuffer *rb, const GameModel *game);
+
+// Recule (steps > 0) ou avance (steps < 0) dans l'historique et restaure l'état
+// correspondant. Renvoie le nombre de ticks réellement parcourus.
+int rewind_step(RewindBuffer *rb, GameModel *game, int steps);
+
+// Reprise du jeu : les snapshots postérieurs à la position courante sont oubliés
+void rewind_commit(RewindBuffer *rb);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,89 @@
+//
+//  starfield.c
+//
+
+#include <stdlib.h>
+#include "starfield.h"
+
+bool starfield_init(Starfield *sf, int count, float width, float height, uint64_t seed, uint64_t stream)
+{
+    sf->pos = malloc((size_t)count * sizeof(SDL_FPoint));
+    sf->speed = malloc((size_t)count * sizeof(float));
+    sf->rects = malloc((size_t)count * sizeof(SDL_FRect));
+    if (!sf->pos || !sf->speed || !sf->rects)
+    {
+        starfield_free(sf);
+        return false;
+    }
+    sf->count = count;
+    sf->width = width;
+    sf->height = height;
+    rng_seed(&sf->rng, seed, stream);
+
+    // Même nombre d'étoiles par tranche ; la vitesse est tirée dans
+    // l'intervalle de la tranche, qui fixe aussi la luminosité
+    for (int b = 0; b <= STARFIELD_BUCKETS; b++)
+        sf->bucket_start[b] = (int)((long)count * b / STARFIELD_BUCKETS);
+    for (int b = 0; b < STARFIELD_BUCKETS; b++)
+    {
+        for (int i = sf->bucket_start[b]; i < sf->bucket_start[b + 1]; i++)
+        {
+            float ratio = (b + rng_float(&sf->rng)) / STARFIELD_BUCKETS;
+            sf->pos[i].x = (float)rng_range(&sf->rng, (uint32_t)width);
+            sf->pos[i].y = rng_float(&sf->rng) * height;
+            sf->speed[i] = STARFIELD_SPEED_MIN + ratio * (STARFIELD_SPEED_MAX - STARFIELD_SPEED_MIN);
+        }
+    }
+    return true;
+}
+
+void starfield_free(Starfield *sf)
+{
+    free(sf->pos);
+    free(sf->speed);
+    free(sf->rects);
+    sf->pos = NULL;
+    sf->speed = NULL;
+    sf->rects = NULL;
+    sf->count = 0;
+}
+
+void starfield_update(Starfield *sf, float dt)
+{
+    if (dt > STARFIELD_MAX_DT)
+        dt = STARFIELD_MAX_DT;
+    for (int i = 0; i < sf->count; i++)
+    {
+        sf->pos[i].y += sf->speed[i] * dt;
+        if (sf->pos[i].y > sf->height)
+        {
+            sf->pos[i].y -= sf->height;
+            sf->pos[i].x = (float)rng_range(&sf->rng, (uint32_t)sf->width);
+        }
+    }
+}
+
+int starfield_draw(Starfield *sf, SDL_Renderer *renderer)
+{
+    int calls = 0;
+    for (int b = 0; b < STARFIELD_BUCKETS; b++)
+    {
+        int start = sf->bucket_start[b];
+        int n = sf->bucket_start[b + 1] - start;
+        if (n == 0)
+            continue;
+
+        Uint8 brightness = (Uint8)(100 + (b * 2 + 1) * 155 / (2 * STARFIELD_BUCKETS));
+        SDL_SetRenderDrawColor(renderer, brightness, brightness, brightness, 255);
+        if (b < STARFIELD_BIG_BUCKET)
+            SDL_RenderPoints(renderer, &sf->pos[start], n);
+        else
+        {
+            for (int i = 0; i < n; i++)
+                sf->rects[i] = (SDL_FRect){sf->pos[start + i].x, sf->pos[start + i].y, 2.0f, 2.0f};
+            SDL_RenderFillRects(renderer, sf->rects, n);
+        }
+        calls++;
+    }
+    return calls;
+}
@@ -0,0 +1,45 @@
+//
+//  starfield.h
+//
+//  Fond étoilé défilant, partagé par le launcher et la vue SDL.
+//  Les étoiles avancent en pixels par seconde (indépendant de la cadence
+//  d'affichage) et sont rangées par tranche de luminosité : une tranche =
+//  une couleur = un seul appel de dessin (SDL_RenderPoints pour les petites,
+//  SDL_RenderFillRects pour les plus proches, en 2x2). Les plus brillantes
+//  sont les plus rapides : effet de parallaxe.
+//
+
+#ifndef STARFIELD_H
+#define STARFIELD_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "rng.h"
+
+#define STARFIELD_BUCKETS 8
+#define STARFIELD_BIG_BUCKET 5 // à partir de cette tranche, étoiles en 2x2
+#define STARFIELD_SPEED_MIN 30.0f  // px/s
+#define STARFIELD_SPEED_MAX 180.0f // px/s
+#define STARFIELD_MAX_DT 0.1f      // au-delà (fenêtre bloquée...), pas de saut
+
+typedef struct
+{
+    SDL_FPoint *pos; // rangées par tranche : chaque tranche est contiguë
+    float *speed;
+    SDL_FRect *rects; // tampon pour les étoiles 2x2
+    int count;
+    int bucket_start[STARFIELD_BUCKETS + 1];
+    float width, height;
+    Rng rng;
+} Starfield;
+
+bool starfield_init(Starfield *sf, int count, float width, float height, uint64_t seed, uint64_t stream);
+void starfield_free(Starfield *sf);
+
+// Fait défiler de dt secondes
+void starfield_update(Starfield *sf, float dt);
+
+// Dessine toutes les étoiles ; renvoie le nombre d'appels de dessin
+int starfield_draw(Starfield *sf, SDL_Renderer *renderer);
+
+#endif // STARFIELD_H
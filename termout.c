@@ -0,0 +1,323 @@
+//
+//  termout.c
+//
+
+#define _POSIX_C_SOURCE 200809L
+#include "termout.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "trace.h"
+
+#define OUT_BUFFER_SIZE 65536 // octets au plus par image envoyée
+#define OUT_HUD_LEN 128
+#define OUT_MAX_SLEEP_NS 50000000L // attente de jetons découpée : l'arrêt reste réactif
+
+static pthread_t thread;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static bool running = false;
+
+// Boîte aux lettres : dernière image déposée, protégée par lock
+static chtype *mail_cells = NULL;
+static uint8_t *mail_prio = NULL;
+static char mail_hud[OUT_HUD_LEN];
+static uint64_t mail_seq = 0;
+
+// Côté thread : écran complet (ligne de HUD + terrain)
+static int rows = 0, cols = 0, play_rows = 0;
+static chtype *want_cells = NULL, *screen_cells = NULL;
+static uint8_t *want_prio = NULL, *screen_prio = NULL;
+static double rate = 0, tokens = 0, tokens_max = 0;
+static char out[OUT_BUFFER_SIZE];
+static int out_len = 0;
+static int cursor_y = -1, cursor_x = -1; // -1 : position inconnue
+static chtype cursor_attr = (chtype)-1;
+
+static TermOutStats stats; // compteurs lus par la boucle de jeu (atomiques)
+static uint64_t start_ns = 0;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void write_all(const char *buf, int len)
+{
+    while (len > 0)
+    {
+        ssize_t n = write(STDOUT_FILENO, buf, (size_t)len);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return; // terminal fermé : rien d'autre à faire
+        }
+        buf += n;
+        len -= (int)n;
+    }
+}
+
+// Ajoute la cellule au tampon de sortie si elle tient dans la limite
+static bool emit_cell(int y, int x, chtype ch, int limit)
+{
+    char seq[48];
+    int n = 0;
+    chtype attr = ch & (A_BOLD | A_REVERSE);
+    if (y != cursor_y || x != cursor_x)
+    {
+        // Petit saut sur la même ligne : réécrire les cellules déjà à jour
+        // coûte moins cher qu'un déplacement du curseur
+        int gap = x - cursor_x;
+        bool same_row = (y == cursor_y && cursor_x >= 0 && gap > 0);
+        bool reuse = same_row && gap <= 3;
+        for (int i = cursor_x; reuse && i < x; i++)
+        {
+            int k = y * cols + i;
+            reuse = screen_cells[k] == want_cells[k] && (screen_cells[k] & (A_BOLD | A_REVERSE)) == cursor_attr;
+        }
+        if (reuse)
+            for (int i = cursor_x; i < x; i++)
+                seq[n++] = (char)(screen_cells[y * cols + i] & A_CHARTEXT);
+        else if (same_row)
+            n += snprintf(seq + n, sizeof(seq) - n, "\033[%dC", gap);
+        else
+            n += snprintf(seq + n, sizeof(seq) - n, "\033[%d;%dH", y + 1, x + 1);
+    }
+    if (attr != cursor_attr)
+        n += snprintf(seq + n, sizeof(seq) - n, "\033[0%s%sm", (attr & A_BOLD) ? ";1" : "",
+                      (attr & A_REVERSE) ? ";7" : "");
+    char c = (char)(ch & A_CHARTEXT);
+    seq[n++] = (c >= ' ' && c < 127) ? c : ' ';
+    if (out_len + n > limit)
+        return false;
+
+    memcpy(out + out_len, seq, (size_t)n);
+    out_len += n;
+    cursor_y = y;
+    cursor_x = (x + 1 < cols) ? x + 1 : -1; // dernière colonne : retour à la ligne incertain
+    cursor_attr = attr;
+    return true;
+}
+
+// Envoie les cellules qui diffèrent de l'écran, par priorité décroissante,
+// tant que les jetons le permettent. Les autres restent différentes et
+// repartiront avec une image suivante.
+static void draw_frame(void)
+{
+    int limit = tokens < OUT_BUFFER_SIZE ? (int)tokens : OUT_BUFFER_SIZE;
+    int n = rows * cols;
+    uint64_t deferred = 0;
+    bool full = false;
+    out_len = 0;
+
+    for (int p = TERM_PRIO_HUD; p >= TERM_PRIO_LOW; p--)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            if (want_cells[i] == screen_cells[i])
+                continue;
+            // Effacer une cellule coûte la priorité de ce qu'elle affichait
+            int prio = want_prio[i] > screen_prio[i] ? want_prio[i] : screen_prio[i];
+            if (prio != p)
+                continue;
+            if (full || !emit_cell(i / cols, i % cols, want_cells[i], limit))
+            {
+                full = true;
+                deferred++;
+                continue;
+            }
+            screen_cells[i] = want_cells[i];
+            screen_prio[i] = want_prio[i];
+        }
+    }
+
+    if (out_len)
+    {
+        write_all(out, out_len);
+        tokens -= out_len;
+        __atomic_add_fetch(&stats.bytes, (uint64_t)out_len, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&stats.frames_written, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&stats.cells_deferred, deferred, __ATOMIC_RELAXED);
+}
+
+// Recopie la boîte aux lettres (appelé sous lock) : HUD en ligne 0
+static void take_frame(void)
+{
+    size_t len = strlen(mail_hud);
+    for (int x = 0; x < cols; x++)
+    {
+        want_cells[x] = (chtype)(unsigned char)((size_t)x < len ? mail_hud[x] : ' ');
+        want_prio[x] = TERM_PRIO_HUD;
+    }
+    size_t n = (size_t)play_rows * cols;
+    memcpy(want_cells + cols, mail_cells, n * sizeof(chtype));
+    memcpy(want_prio + cols, mail_prio, n);
+}
+
+static void refill_tokens(uint64_t *last)
+{
+    uint64_t now = now_ns();
+    tokens += rate * (double)(now - *last) / 1e9;
+    if (tokens > tokens_max)
+        tokens = tokens_max;
+    *last = now;
+}
+
+static void *output_thread(void *arg)
+{
+    (void)arg;
+    trace_thread_name("terminal");
+    uint64_t seen = 0;
+    uint64_t last = now_ns();
+
+    pthread_mutex_lock(&lock);
+    while (running)
+    {
+        if (mail_seq == seen)
+        {
+            pthread_cond_wait(&wake, &lock);
+            continue;
+        }
+
+        // Pas assez de jetons : on attend, puis on reprend la dernière image
+        // déposée entre-temps (les intermédiaires sont fusionnées)
+        refill_tokens(&last);
+        if (tokens < TERM_OUT_MIN_BYTES)
+        {
+            long wait_ns = (long)((TERM_OUT_MIN_BYTES - tokens) / rate * 1e9) + 1;
+            struct timespec ts = {0, wait_ns < OUT_MAX_SLEEP_NS ? wait_ns : OUT_MAX_SLEEP_NS};
+            pthread_mutex_unlock(&lock);
+            nanosleep(&ts, NULL);
+            pthread_mutex_lock(&lock);
+            continue;
+        }
+
+        take_frame();
+        seen = mail_seq;
+        pthread_mutex_unlock(&lock);
+
+        TRACE_BEGIN("terminal_write");
+        draw_frame();
+        TRACE_END("terminal_write");
+
+        pthread_mutex_lock(&lock);
+    }
+    pthread_mutex_unlock(&lock);
+    trace_thread_exit(); // le thread relancé au prochain redimensionnement reprendra ce tampon
+    return NULL;
+}
+
+static void free_grids(void)
+{
+    free(mail_cells);
+    free(mail_prio);
+    free(want_cells);
+    free(want_prio);
+    free(screen_cells);
+    free(screen_prio);
+    mail_cells = want_cells = screen_cells = NULL;
+    mail_prio = want_prio = screen_prio = NULL;
+}
+
+bool term_out_start(int field_rows, int field_cols, long bytes_per_second)
+{
+    if (running || bytes_per_second <= 0)
+        return false;
+
+    play_rows = field_rows;
+    rows = field_rows + 1;
+    cols = field_cols;
+    size_t n = (size_t)rows * cols;
+    mail_cells = malloc((size_t)play_rows * cols * sizeof(chtype));
+    mail_prio = malloc((size_t)play_rows * cols);
+    want_cells = malloc(n * sizeof(chtype));
+    want_prio = malloc(n);
+    screen_cells = malloc(n * sizeof(chtype));
+    screen_prio = malloc(n);
+    if (!mail_cells || !mail_prio || !want_cells || !want_prio || !screen_cells || !screen_prio)
+    {
+        fprintf(stderr, "❌ Mémoire insuffisante pour la sortie terminal\n");
+        free_grids();
+        return false;
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        screen_cells[i] = ' ';
+        screen_prio[i] = TERM_PRIO_LOW;
+    }
+
+    rate = (double)bytes_per_second;
+    tokens_max = rate * TERM_OUT_BURST_SECONDS;
+    if (tokens_max < TERM_OUT_MIN_BYTES)
+        tokens_max = TERM_OUT_MIN_BYTES;
+    if (tokens_max > OUT_BUFFER_SIZE)
+        tokens_max = OUT_BUFFER_SIZE;
+    tokens = tokens_max;
+    cursor_y = cursor_x = -1;
+    cursor_attr = (chtype)-1;
+    mail_seq = 0;
+    if (!start_ns)
+        start_ns = now_ns();
+
+    running = true;
+    if (pthread_create(&thread, NULL, output_thread, NULL) != 0)
+    {
+        fprintf(stderr, "❌ Impossible de lancer le thread de sortie terminal\n");
+        running = false;
+        free_grids();
+        return false;
+    }
+    return true;
+}
+
+void term_out_stop(void)
+{
+    if (!running)
+        return;
+    pthread_mutex_lock(&lock);
+    running = false;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+    pthread_join(thread, NULL);
+
+    write_all("\033[0m", 4); // attributs remis à zéro avant de rendre la main à ncurses
+    free_grids();
+}
+
+bool term_out_post(const chtype *cells, const uint8_t *prio, const char *hud)
+{
+    if (!running)
+        return false;
+    __atomic_add_fetch(&stats.frames_posted, 1, __ATOMIC_RELAXED);
+    // Le thread ne garde le verrou que le temps d'une copie : s'il le tient,
+    // on saute l'image plutôt que d'attendre
+    if (pthread_mutex_trylock(&lock) != 0)
+        return false;
+    size_t n = (size_t)play_rows * cols;
+    memcpy(mail_cells, cells, n * sizeof(chtype));
+    memcpy(mail_prio, prio, n);
+    snprintf(mail_hud, sizeof(mail_hud), "%s", hud);
+    mail_seq++;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+    return true;
+}
+
+TermOutStats term_out_stats(void)
+{
+    TermOutStats s;
+    s.bytes = __atomic_load_n(&stats.bytes, __ATOMIC_RELAXED);
+    s.frames_posted = __atomic_load_n(&stats.frames_posted, __ATOMIC_RELAXED);
+    s.frames_written = __atomic_load_n(&stats.frames_written, __ATOMIC_RELAXED);
+    s.cells_deferred = __atomic_load_n(&stats.cells_deferred, __ATOMIC_RELAXED);
+    s.seconds = start_ns ? (now_ns() - start_ns) / 1e9 : 0;
+    return s;
+}
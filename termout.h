@@ -0,0 +1,55 @@
+//
+//  termout.h
+//
+//  Sortie terminal à débit limité pour la vue ncurses (--bandwidth=octets/s),
+//  pensée pour le SSH sur liaison lente.
+//
+//  Un thread dédié possède l'écriture sur le terminal : la boucle de jeu lui
+//  dépose la dernière image (grille de cellules + priorités + HUD) sans
+//  jamais attendre ; si le thread est occupé ou bloqué dans write(), l'image
+//  précédente non envoyée est simplement remplacée. Le thread compare
+//  l'image à ce qu'affiche le terminal et écrit lui-même les séquences ANSI,
+//  dans la limite d'un seau de jetons (octets par seconde) : cellules
+//  prioritaires d'abord, les autres attendent l'image suivante, et les
+//  cellules de basse priorité (explosions) sont les premières abandonnées.
+//
+
+#ifndef TERMOUT_H
+#define TERMOUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <ncurses.h>
+
+typedef enum
+{
+    TERM_PRIO_LOW,    // vide, explosions : abandonnées en premier
+    TERM_PRIO_NORMAL, // aliens, boss, balles, items
+    TERM_PRIO_HIGH,   // joueur, menus, overlay
+    TERM_PRIO_HUD     // ligne de score
+} TermPriority;
+
+#define TERM_OUT_BURST_SECONDS 0.2 // réserve max du seau de jetons
+#define TERM_OUT_MIN_BYTES 64      // en dessous, on attend plutôt que d'envoyer une image
+
+typedef struct
+{
+    uint64_t bytes;          // octets écrits sur le terminal
+    uint64_t frames_posted;  // images déposées par la boucle de jeu
+    uint64_t frames_written; // images (même partielles) envoyées au terminal
+    uint64_t cells_deferred; // cellules remises à plus tard faute de budget
+    double seconds;          // durée depuis term_out_start
+} TermOutStats;
+
+// Démarre le thread de sortie pour un terrain de rows x cols cellules (sous
+// la ligne de HUD). L'écran est supposé vide.
+bool term_out_start(int rows, int cols, long bytes_per_second);
+void term_out_stop(void);
+
+// Dépose la dernière image, sans bloquer : renvoie false si le thread tenait
+// la boîte aux lettres (l'image est alors sautée).
+bool term_out_post(const chtype *cells, const uint8_t *prio, const char *hud);
+
+TermOutStats term_out_stats(void);
+
+#endif // TERMOUT_H
@@ -0,0 +1,135 @@
+//
+//  timer.c
+//
+
+#include "timer.h"
+
+#define TIMER_READY (TIMER_BUCKETS - 1)
+#define TIMER_MASK (TIMER_WHEEL_SLOTS - 1)
+
+// --- LISTES DOUBLEMENT CHAÎNÉES PAR INDEX ---
+
+static void list_append(TimerWheel *w, int bucket, int id)
+{
+    Timer *t = &w->timers[id];
+    t->bucket = (uint8_t)bucket;
+    t->next = TIMER_NONE;
+    t->prev = w->tail[bucket];
+    if (t->prev != TIMER_NONE)
+        w->timers[t->prev].next = (int16_t)id;
+    else
+        w->head[bucket] = (int16_t)id;
+    w->tail[bucket] = (int16_t)id;
+}
+
+static void list_remove(TimerWheel *w, int id)
+{
+    Timer *t = &w->timers[id];
+    if (t->prev != TIMER_NONE)
+        w->timers[t->prev].next = t->next;
+    else
+        w->head[t->bucket] = t->next;
+    if (t->next != TIMER_NONE)
+        w->timers[t->next].prev = t->prev;
+    else
+        w->tail[t->bucket] = t->prev;
+}
+
+// Case de la roue selon l'échéance, relativement à w->now
+static void wheel_insert(TimerWheel *w, int id)
+{
+    uint32_t expires = w->timers[id].expires;
+    uint32_t delta = expires - w->now;
+    int bucket;
+    if (delta < TIMER_WHEEL_SLOTS)
+        bucket = (int)(expires & TIMER_MASK);
+    else
+    {
+        // Trop loin pour le niveau 1 : dernière case, reclassé quand elle passe
+        if (delta >= (uint32_t)TIMER_WHEEL_SLOTS * TIMER_WHEEL_SLOTS)
+            expires = w->now + (uint32_t)TIMER_WHEEL_SLOTS * (TIMER_WHEEL_SLOTS - 1);
+        bucket = TIMER_WHEEL_SLOTS + (int)((expires >> TIMER_WHEEL_BITS) & TIMER_MASK);
+    }
+    list_append(w, bucket, id);
+}
+
+void timer_wheel_init(TimerWheel *w, uint32_t now)
+{
+    for (int b = 0; b < TIMER_BUCKETS; b++)
+        w->head[b] = w->tail[b] = TIMER_NONE;
+    for (int i = 0; i < TIMER_MAX; i++)
+        w->timers[i] = (Timer){0, 0, 0, 0, TIMER_NONE, (int16_t)(i + 1 < TIMER_MAX ? i + 1 : TIMER_NONE)};
+    w->free_list = 0;
+    w->now = now;
+}
+
+int timer_add(TimerWheel *w, uint32_t delay, uint8_t kind, uint16_t arg)
+{
+    int id = w->free_list;
+    if (id == TIMER_NONE)
+        return TIMER_NONE;
+    w->free_list = w->timers[id].next;
+
+    Timer *t = &w->timers[id];
+    t->expires = w->now + (delay ? delay : 1);
+    t->kind = kind;
+    t->arg = arg;
+    wheel_insert(w, id);
+    return id;
+}
+
+static void timer_release(TimerWheel *w, int id)
+{
+    w->timers[id].next = w->free_list;
+    w->free_list = (int16_t)id;
+}
+
+void timer_cancel(TimerWheel *w, int id)
+{
+    if (id == TIMER_NONE)
+        return;
+    list_remove(w, id);
+    timer_release(w, id);
+}
+
+void timer_wheel_advance(TimerWheel *w, uint32_t now)
+{
+    w->now = now;
+
+    // Début d'un bloc de 64 ticks : la case correspondante du niveau 1 descend
+    if ((now & TIMER_MASK) == 0)
+    {
+        int bucket = TIMER_WHEEL_SLOTS + (int)((now >> TIMER_WHEEL_BITS) & TIMER_MASK);
+        int id = w->head[bucket];
+        w->head[bucket] = w->tail[bucket] = TIMER_NONE;
+        while (id != TIMER_NONE)
+        {
+            int next = w->timers[id].next;
+            wheel_insert(w, id);
+            id = next;
+        }
+    }
+
+    // La case du tick courant ne contient que des minuteurs échus maintenant
+    int slot = (int)(now & TIMER_MASK);
+    int id = w->head[slot];
+    w->head[slot] = w->tail[slot] = TIMER_NONE;
+    while (id != TIMER_NONE)
+    {
+        int next = w->timers[id].next;
+        list_append(w, TIMER_READY, id);
+        id = next;
+    }
+}
+
+bool timer_pop(TimerWheel *w, uint8_t *kind, uint16_t *arg)
+{
+    int id = w->head[TIMER_READY];
+    if (id == TIMER_NONE)
+        return false;
+    list_remove(w, id);
+    *kind = w->timers[id].kind;
+    *arg = w->timers[id].arg;
+    timer_release(w, id);
+    return true;
+}
@@ -0,0 +1,71 @@
+//
+//  timer.h
+//
+//  Roue de minuteurs hiérarchique, comptée en ticks de simulation.
+//  Niveau 0 : 64 cases d'un tick (~0.5 s à 120 Hz) ; niveau 1 : 64 cases de
+//  64 ticks (~34 s). Un minuteur lointain attend au niveau 1 et descend au
+//  niveau 0 quand sa case arrive ; au-delà de 34 s il est reclassé à chaque
+//  passage. Un tick ne touche que sa case : aucun travail pour les minuteurs
+//  qui ne sont pas échus.
+//
+//  Tout est en tableaux d'index (pas de pointeurs) : la roue vit dans le
+//  GameModel, elle est copiée par les snapshots et rejouée à l'identique.
+//  Dans une même case, les minuteurs expirent dans l'ordre où ils ont été posés.
+//
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TIMER_MAX 64 // minuteurs actifs simultanés
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_BUCKETS (2 * TIMER_WHEEL_SLOTS + 1) // niveau 0, niveau 1, liste "échus"
+#define TIMER_NONE (-1)
+
+typedef struct
+{
+    uint32_t expires; // tick d'expiration
+    uint8_t kind;     // signification laissée à l'appelant (TimerKind du modèle)
+    uint8_t bucket;   // case qui contient le minuteur
+    uint16_t arg;     // par exemple un index de slot
+    int16_t prev, next;
+} Timer;
+
+typedef struct
+{
+    Timer timers[TIMER_MAX];
+    int16_t head[TIMER_BUCKETS];
+    int16_t tail[TIMER_BUCKETS];
+    int16_t free_list;
+    uint32_t now; // dernier tick traité par timer_wheel_advance
+} TimerWheel;
+
+void timer_wheel_init(TimerWheel *w, uint32_t now);
+
+// Pose un minuteur qui expire dans `delay` ticks (au moins 1).
+// Renvoie son identifiant, ou TIMER_NONE si la roue est pleine.
+int timer_add(TimerWheel *w, uint32_t delay, uint8_t kind, uint16_t arg);
+
+// Annule un minuteur encore en attente
+void timer_cancel(TimerWheel *w, int id);
+
+// Passe au tick `now` (now = w->now + 1) : les minuteurs échus sont mis de côté
+// et récupérés un par un avec timer_pop.
+void timer_wheel_advance(TimerWheel *w, uint32_t now);
+
+// Prochain minuteur échu (libéré avant le retour), false quand il n'y en a plus
+bool timer_pop(TimerWheel *w, uint8_t *kind, uint16_t *arg);
+
+// Ticks restants avant expiration
+static inline uint32_t timer_remaining(const TimerWheel *w, int id)
+{
+    return w->timers[id].expires - w->now;
+}
+
+// Convertit une durée en secondes en ticks (arrondi au tick supérieur)
+#define TIMER_TICKS(seconds, hz) ((uint32_t)((seconds) * (hz) + 0.999f))
+
+#endif // TIMER_H
@@ -0,0 +1,205 @@
+//
+//  trace.c
+//
+
+#define _POSIX_C_SOURCE 199309L
+#include "trace.h"
+
+#if TRACE_ENABLED
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct
+{
+    const char *name;
+    uint64_t ts_ns;
+    char phase; // 'B' ou 'E'
+} TraceEvent;
+
+typedef struct
+{
+    TraceEvent *events;
+    uint32_t count;
+    uint32_t dropped;
+    const char *thread_name;
+    int in_use; // tenu par un thread vivant (atomique)
+} TraceBuffer;
+
+bool trace_active = false;
+
+static TraceBuffer buffers[TRACE_MAX_THREADS];
+static int thread_count = 0;                  // tampons attribués (atomique)
+static uint32_t refused = 0;                  // événements de threads sans tampon (atomique)
+static __thread TraceBuffer *local = NULL;    // tampon du thread courant
+static __thread bool local_full = false;      // plus de tampon libre pour ce thread
+static const char *trace_path = NULL;
+static uint64_t trace_start_ns = 0;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Premier événement d'un thread : il reprend le tampon libéré d'un thread
+// de même nom, sinon il prend le tampon suivant
+static TraceBuffer *claim_buffer(const char *name)
+{
+    int count = __atomic_load_n(&thread_count, __ATOMIC_ACQUIRE);
+    for (int t = 0; name && t < count && t < TRACE_MAX_THREADS; t++)
+    {
+        const char *owner = __atomic_load_n(&buffers[t].thread_name, __ATOMIC_ACQUIRE);
+        int expected = 0;
+        if (owner && strcmp(owner, name) == 0 &&
+            __atomic_compare_exchange_n(&buffers[t].in_use, &expected, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        {
+            local = &buffers[t];
+            return local;
+        }
+    }
+
+    int i = __atomic_fetch_add(&thread_count, 1, __ATOMIC_ACQ_REL);
+    if (i >= TRACE_MAX_THREADS)
+    {
+        local_full = true;
+        return NULL;
+    }
+    local = &buffers[i];
+    __atomic_store_n(&local->in_use, 1, __ATOMIC_RELEASE);
+    return local;
+}
+
+void trace_record(const char *name, char phase)
+{
+    TraceBuffer *b = local;
+    if (!b)
+    {
+        if (local_full || !(b = claim_buffer(NULL)))
+        {
+            __atomic_add_fetch(&refused, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+    if (b->count == TRACE_EVENTS_PER_THREAD)
+    {
+        b->dropped++;
+        return;
+    }
+    b->events[b->count++] = (TraceEvent){name, now_ns(), phase};
+}
+
+void trace_thread_name(const char *name)
+{
+    if (!trace_active)
+        return;
+    if (local || (!local_full && claim_buffer(name)))
+        __atomic_store_n(&local->thread_name, name, __ATOMIC_RELEASE);
+}
+
+void trace_thread_exit(void)
+{
+    if (local)
+        __atomic_store_n(&local->in_use, 0, __ATOMIC_RELEASE);
+    local = NULL;
+    local_full = false;
+}
+
+static void write_json_string(FILE *f, const char *s)
+{
+    fputc('"', f);
+    for (; *s; s++)
+    {
+        if (*s == '"' || *s == '\\')
+            fputc('\\', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static void trace_flush(void)
+{
+    if (!trace_active)
+        return;
+    trace_active = false;
+
+    FILE *f = fopen(trace_path, "w");
+    if (!f)
+    {
+        fprintf(stderr, "❌ Impossible d'écrire la trace %s\n", trace_path);
+        return;
+    }
+
+    int threads = thread_count < TRACE_MAX_THREADS ? thread_count : TRACE_MAX_THREADS;
+    uint64_t total = 0, dropped = __atomic_load_n(&refused, __ATOMIC_RELAXED);
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (int t = 0; t < threads; t++)
+    {
+        TraceBuffer *b = &buffers[t];
+        int tid = t + 1;
+        if (b->thread_name)
+        {
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", first ? "" : ",\n", tid);
+            write_json_string(f, b->thread_name);
+            fprintf(f, "}}");
+            first = false;
+        }
+
+        int depth = 0;
+        uint64_t last_ts = trace_start_ns;
+        for (uint32_t i = 0; i < b->count; i++)
+        {
+            const TraceEvent *e = &b->events[i];
+            fprintf(f, "%s{\"name\":", first ? "" : ",\n");
+            write_json_string(f, e->name);
+            fprintf(f, ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", e->phase,
+                    (e->ts_ns - trace_start_ns) / 1000.0, tid);
+            first = false;
+            depth += (e->phase == 'B') ? 1 : -1;
+            last_ts = e->ts_ns;
+        }
+        // Tampon plein en cours de route : on referme les tranches restées ouvertes
+        for (; depth > 0; depth--)
+            fprintf(f, ",\n{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", (last_ts - trace_start_ns) / 1000.0, tid);
+
+        total += b->count;
+        dropped += b->dropped;
+        free(b->events);
+        b->events = NULL;
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+
+    printf("📈 Trace écrite : %s (%llu événements", trace_path, (unsigned long long)total);
+    if (dropped)
+        printf(", %llu perdus tampon plein ou plus de tampon libre", (unsigned long long)dropped);
+    printf(")\n");
+}
+
+bool trace_init(const char *path)
+{
+    for (int t = 0; t < TRACE_MAX_THREADS; t++)
+    {
+        buffers[t].events = malloc(TRACE_EVENTS_PER_THREAD * sizeof(TraceEvent));
+        if (!buffers[t].events)
+        {
+            fprintf(stderr, "❌ Mémoire insuffisante pour la trace\n");
+            for (int u = 0; u < t; u++)
+                free(buffers[u].events);
+            return false;
+        }
+    }
+    trace_path = path;
+    trace_start_ns = now_ns();
+    trace_active = true;
+    atexit(trace_flush);
+    trace_thread_name("main");
+    return true;
+}
+
+#endif // TRACE_ENABLED
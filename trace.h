@@ -0,0 +1,76 @@
+//
+//  trace.h
+//
+//  Enregistrement d'événements début/fin (--trace=fichier.json), exportés à
+//  la sortie du programme au format "trace event" de Chrome / Perfetto
+//  (chrome://tracing, ui.perfetto.dev).
+//
+//  Chaque thread écrit dans son propre tampon, alloué une fois par
+//  trace_init : enregistrer un événement = lire l'horloge et remplir une case,
+//  sans verrou, sans allocation ni entrée/sortie. Tampon plein, ou plus de
+//  tampon libre pour un nouveau thread : les événements sont comptés comme
+//  perdus. Un thread relancé (sortie terminal après redimensionnement)
+//  reprend le tampon de son prédécesseur de même nom, libéré par
+//  trace_thread_exit. Les noms doivent être des chaînes littérales (seul le
+//  pointeur est gardé).
+//
+//  Sans --trace, chaque macro coûte un test ; compilé avec -DTRACE_ENABLED=0,
+//  elles disparaissent.
+//
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+#define TRACE_MAX_THREADS 4
+#define TRACE_EVENTS_PER_THREAD (1 << 20) // ~24 Mo par thread, pages touchées à l'usage
+
+#if TRACE_ENABLED
+
+extern bool trace_active;
+
+// Alloue les tampons et programme l'écriture de `path` à la sortie (atexit)
+bool trace_init(const char *path);
+
+// Nom du thread appelant dans la trace ; reprend, s'il existe, le tampon
+// libre d'un thread terminé du même nom
+void trace_thread_name(const char *name);
+
+// Fin du thread appelant : son tampon peut servir à un thread de même nom
+void trace_thread_exit(void);
+
+void trace_record(const char *name, char phase);
+
+#define TRACE_BEGIN(name)               \
+    do                                  \
+    {                                   \
+        if (trace_active)               \
+            trace_record((name), 'B');  \
+    } while (0)
+#define TRACE_END(name)                 \
+    do                                  \
+    {                                   \
+        if (trace_active)               \
+            trace_record((name), 'E');  \
+    } while (0)
+
+#else
+
+static inline bool trace_init(const char *path)
+{
+    (void)path;
+    return false;
+}
+#define trace_thread_name(name) ((void)0)
+#define trace_thread_exit() ((void)0)
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END(name) ((void)0)
+
+#endif // TRACE_ENABLED
+
+#endif // TRACE_H
@@ -16,13 +16,18 @@ typedef struct
     void (*close)(void);
     void (*render)(const GameModel *model);
 
-    KEY_BOUTONS (*get_input)(void);
+    // Remplit *input : boutons tenus et appuis en attente depuis l'appel précédent
+    void (*get_input)(InputState *input);
+
+    // Événements du modèle depuis l'image précédente (sons, effets), une fois par image
+    void (*handle_events)(const ModelEvent *events, int count);
 } GameView;
 
 GameView view_ncurses_get_interface(void);
 GameView view_sdl_get_interface(void);
-void play_item_sound(void);
-void play_explosion_sound(void);
-void play_shoot_sound(void);
+
+// Débit maximal vers le terminal en mode ncurses (octets/s, 0 = sans limite),
+// à régler avant init
+void view_ncurses_set_bandwidth(long bytes_per_second);
 
 #endif
\ No newline at end of file
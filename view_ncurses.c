@@ -4,43 +4,229 @@
 //
 //  Created by Cakir on 24/12/2025.
 //
+//  Rendu par différence : chaque image est construite dans une grille de
+//  cellules en mémoire, comparée à la précédente, et seules les cellules
+//  modifiées sont passées à ncurses. Plus de clear() : le terminal ne reçoit
+//  que ce qui a bougé (utile en SSH, et plus de scintillement).
+//  Ligne de HUD et terrain sont deux fenêtres séparées ; le HUD n'est
+//  réécrit que quand son texte change.
+//
+//  Avec --bandwidth=octets/s, ncurses ne sert plus qu'au clavier et à
+//  l'initialisation du terminal : les images partent vers le thread de
+//  sortie de termout.c, qui respecte le débit et ne bloque jamais la boucle
+//  de jeu. Chaque cellule porte une priorité (explosions en dernier).
+//
+#define _POSIX_C_SOURCE 200809L
 #include "view.h"
 #include <ncurses.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include "perf.h"
+#include "termout.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static bool show_perf = false; // overlay de performance (F3 ou 'o')
+static long bandwidth = 0;      // octets/s vers le terminal, 0 = sans limite
+
+void view_ncurses_set_bandwidth(long bytes_per_second)
+{
+    bandwidth = bytes_per_second > 0 ? bytes_per_second : 0;
+}
+
+// --- GRILLE DE CELLULES ---
+
+static WINDOW *hud_win = NULL;
+static WINDOW *play_win = NULL;
+static chtype *cells_front = NULL; // ce que le terminal affiche
+static chtype *cells_back = NULL;  // image en construction
+static uint8_t *cells_prio = NULL; // TermPriority de chaque cellule de l'image
+static uint8_t draw_prio = TERM_PRIO_NORMAL;
+static int grid_rows = 0, grid_cols = 0;
+static float scale_x = 0, scale_y = 0; // jeu -> cellules, recalculés au redimensionnement
+static bool resize_pending = false;
+static char hud_text[128];
 
-// Convertit les coordonnées du jeu (800x600) vers le terminal
+// Octets écrits sur le terminal
+static uint64_t bytes_total = 0, frames_total = 0, cells_total = 0;
+static long long bytes_max = 0;
+static TermOutStats out_base;      // compteurs du thread de sortie au lancement de la vue
+static uint64_t out_last_bytes = 0;
+
+// (Re)crée les fenêtres et les grilles à la taille du terminal
+static void layout_init(void)
+{
+    if (hud_win)
+        delwin(hud_win);
+    if (play_win)
+        delwin(play_win);
+    term_out_stop(); // le thread de sortie repart à la nouvelle taille
+
+    int rows, cols;
+    getmaxyx(stdscr, rows, cols);
+    grid_rows = rows > 1 ? rows - 1 : 1;
+    grid_cols = cols > 0 ? cols : 1;
+
+    hud_win = newwin(1, grid_cols, 0, 0);
+    play_win = newwin(grid_rows, grid_cols, rows > 1 ? 1 : 0, 0);
+    keypad(play_win, TRUE);
+    nodelay(play_win, TRUE); // Non-bloquant
+
+    free(cells_front);
+    free(cells_back);
+    free(cells_prio);
+    size_t n = (size_t)grid_rows * grid_cols;
+    cells_front = malloc(n * sizeof(chtype));
+    cells_back = malloc(n * sizeof(chtype));
+    cells_prio = malloc(n);
+    // Cellule impossible : tout part au premier rendu
+    for (size_t i = 0; i < n; i++)
+        cells_front[i] = (chtype)-1;
+
+    scale_x = (float)grid_cols / GAME_WIDTH;
+    scale_y = (float)grid_rows / GAME_HEIGHT;
+    hud_text[0] = '\0';
+
+    clearok(curscr, TRUE); // l'ancien contenu n'a plus de sens
+    resize_pending = false;
+
+    if (bandwidth)
+    {
+        // Écran effacé ici, puis les fenêtres ne sont plus jamais touchées :
+        // wgetch() ne repeint rien et seul le thread de sortie écrit
+        wnoutrefresh(hud_win);
+        wnoutrefresh(play_win);
+        doupdate();
+        term_out_start(grid_rows, grid_cols, bandwidth);
+    }
+}
+
+// Convertit les coordonnées du jeu (1280x800) vers la grille
 static void transform_coords(float gx, float gy, int *tx, int *ty)
 {
-    int max_y, max_x;
-    getmaxyx(stdscr, max_y, max_x);
+    *tx = (int)(gx * scale_x);
+    *ty = (int)(gy * scale_y);
+}
 
-    // Simple règle de trois
-    *tx = (int)(gx * max_x / GAME_WIDTH);
-    *ty = (int)(gy * max_y / GAME_HEIGHT);
+static void put_cell(int x, int y, chtype ch)
+{
+    if (x < 0 || y < 0 || x >= grid_cols || y >= grid_rows)
+        return;
+    cells_back[y * grid_cols + x] = ch;
+    cells_prio[y * grid_cols + x] = draw_prio;
 }
 
-// --- Implémentation de l'Interface ---
+static void put_text(int x, int y, const char *s, chtype attr)
+{
+    for (; *s; s++, x++)
+        put_cell(x, y, (chtype)(unsigned char)*s | attr);
+}
 
-static void ncurses_init(void)
+static void put_centered(int y, const char *s, chtype attr)
 {
-    initscr();
-    cbreak();
-    noecho();
-    curs_set(0);
-    timeout(0); // Non-bloquant
-    keypad(stdscr, TRUE);
+    put_text(grid_cols / 2 - (int)strlen(s) / 2, y, s, attr);
 }
 
-static void ncurses_close(void)
+// Passe à ncurses les seules cellules qui ont changé ; renvoie leur nombre
+static int flush_cells(void)
 {
-    endwin();
+    int changed = 0;
+    for (int y = 0; y < grid_rows; y++)
+    {
+        chtype *back = &cells_back[y * grid_cols];
+        chtype *front = &cells_front[y * grid_cols];
+        for (int x = 0; x < grid_cols; x++)
+        {
+            if (back[x] == front[x])
+                continue;
+            mvwaddch(play_win, y, x, back[x]);
+            front[x] = back[x];
+            changed++;
+        }
+    }
+    return changed;
+}
+
+// --- MESURE DES OCTETS ÉCRITS ---
+// ncurses écrit directement sur le descripteur du terminal : on lit le
+// compteur d'octets écrits du processus (wchar de /proc/self/io) autour de
+// doupdate(). Ailleurs que sous Linux, la mesure est absente.
+
+#ifdef __linux__
+static int proc_io_fd = -1;
+
+static long long written_bytes(void)
+{
+    if (proc_io_fd < 0)
+        return -1;
+    char buf[512];
+    ssize_t n = pread(proc_io_fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0)
+        return -1;
+    buf[n] = '\0';
+    const char *w = strstr(buf, "wchar:");
+    return w ? atoll(w + 6) : -1;
 }
+#else
+static long long written_bytes(void)
+{
+    return -1;
+}
+#endif
+
+// --- ENTRÉES ---
+// Le terminal n'envoie que des appuis (répétés tant que la touche reste
+// enfoncée), jamais de relâchement. Le premier appui d'une direction est
+// une impulsion : tenue pour ce seul relevé, soit une image de
+// déplacement comme avant le masque de boutons, de quoi viser une colonne.
+// Un nouvel appui moins de NCURSES_REPEAT_WINDOW_NS plus tard (répétition
+// du clavier, ou second appui rapproché) la rend tenue jusqu'à une fois et
+// demie l'intervalle mesuré entre les deux appuis, borné par
+// NCURSES_HOLD_MIN_NS / NCURSES_HOLD_MAX_NS : le déplacement est continu
+// pendant la répétition et s'arrête environ une demi-période après le
+// relâchement. L'appui de la direction opposée la relâche aussitôt.
+// Les autres boutons ne passent que par les appuis (un tir par appui).
+#define NCURSES_REPEAT_WINDOW_NS 700000000LL // au-delà du délai avant répétition (250 à 660 ms)
+#define NCURSES_HOLD_MIN_NS 20000000LL
+#define NCURSES_HOLD_MAX_NS 100000000LL
 
-static KEY_BOUTONS ncurses_get_input(void)
+static int64_t last_press_ns[BTN_DOWN + 1];
+static int64_t hold_until_ns[BTN_DOWN + 1];
+
+static bool is_direction(KEY_BOUTONS btn)
+{
+    return btn == BTN_LEFT || btn == BTN_RIGHT || btn == BTN_UP || btn == BTN_DOWN;
+}
+
+static KEY_BOUTONS opposite_direction(KEY_BOUTONS btn)
+{
+    switch (btn)
+    {
+    case BTN_LEFT:
+        return BTN_RIGHT;
+    case BTN_RIGHT:
+        return BTN_LEFT;
+    case BTN_UP:
+        return BTN_DOWN;
+    default:
+        return BTN_UP;
+    }
+}
+
+static int64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static KEY_BOUTONS key_to_button(int ch)
 {
-    int ch = getch();
-    if (ch == ERR)
-        return BTN_NONE;
     if (ch == 'q' || ch == 'Q' || ch == 27)
         return BTN_QUIT;
     if (ch == ' ')
@@ -60,40 +246,186 @@ static KEY_BOUTONS ncurses_get_input(void)
     return BTN_NONE;
 }
 
+// --- Implémentation de l'Interface ---
+
+static void ncurses_init(void)
+{
+    initscr();
+    cbreak();
+    noecho();
+    curs_set(0);
+    timeout(0); // Non-bloquant
+    keypad(stdscr, TRUE);
+    refresh(); // stdscr ne sera plus touché : plus de rafraîchissement implicite
+    layout_init();
+
+#ifdef __linux__
+    proc_io_fd = open("/proc/self/io", O_RDONLY);
+#endif
+    memset(last_press_ns, 0, sizeof(last_press_ns));
+    memset(hold_until_ns, 0, sizeof(hold_until_ns));
+    bytes_total = frames_total = cells_total = 0;
+    bytes_max = 0;
+    out_base = term_out_stats();
+    out_last_bytes = out_base.bytes;
+}
+
+static void ncurses_close(void)
+{
+    term_out_stop();
+    delwin(hud_win);
+    delwin(play_win);
+    hud_win = play_win = NULL;
+    free(cells_front);
+    free(cells_back);
+    free(cells_prio);
+    cells_front = cells_back = NULL;
+    cells_prio = NULL;
+    endwin();
+
+#ifdef __linux__
+    if (proc_io_fd >= 0)
+        close(proc_io_fd);
+    proc_io_fd = -1;
+#endif
+    if (bandwidth)
+    {
+        TermOutStats s = term_out_stats();
+        uint64_t posted = s.frames_posted - out_base.frames_posted;
+        double seconds = s.seconds - out_base.seconds;
+        printf("🖥️ Terminal limité à %ld octets/s : %.0f octets/s envoyés, %llu images envoyées sur %llu, "
+               "%llu cellules différées\n",
+               bandwidth, seconds > 0 ? (s.bytes - out_base.bytes) / seconds : 0.0,
+               (unsigned long long)(s.frames_written - out_base.frames_written), (unsigned long long)posted,
+               (unsigned long long)(s.cells_deferred - out_base.cells_deferred));
+    }
+    else if (frames_total)
+    {
+        printf("🖥️ Terminal : %.1f cellules modifiées par image", (double)cells_total / frames_total);
+        if (bytes_total)
+            printf(", %.0f octets par image (max %lld)", (double)bytes_total / frames_total, bytes_max);
+        printf(" sur %llu images\n", (unsigned long long)frames_total);
+    }
+}
+
+static void ncurses_get_input(InputState *input)
+{
+    *input = (InputState){0};
+    int64_t now = monotonic_ns();
+
+    // Toutes les touches en attente, lues sur la fenêtre du terrain :
+    // getch() sur stdscr la repeindrait
+    int ch;
+    while ((ch = wgetch(play_win)) != ERR)
+    {
+        if (ch == KEY_RESIZE)
+        {
+            resize_pending = true; // SIGWINCH, traité au prochain rendu
+            continue;
+        }
+        if (ch == KEY_F(3) || ch == 'o' || ch == 'O')
+        {
+            show_perf = !show_perf;
+            continue;
+        }
+        KEY_BOUTONS btn = key_to_button(ch);
+        if (btn == BTN_NONE)
+            continue;
+        input_press(input, btn);
+        if (is_direction(btn))
+        {
+            int64_t since = now - last_press_ns[btn];
+            if (last_press_ns[btn] && since < NCURSES_REPEAT_WINDOW_NS)
+            {
+                int64_t hold = since * 3 / 2;
+                if (hold < NCURSES_HOLD_MIN_NS)
+                    hold = NCURSES_HOLD_MIN_NS;
+                if (hold > NCURSES_HOLD_MAX_NS)
+                    hold = NCURSES_HOLD_MAX_NS;
+                hold_until_ns[btn] = now + hold;
+            }
+            last_press_ns[btn] = now;
+            KEY_BOUTONS other = opposite_direction(btn); // changer de direction relâche l'autre
+            hold_until_ns[other] = last_press_ns[other] = 0;
+            input->held &= (ButtonMask)~BTN_MASK(other);
+        }
+    }
+
+    // Seules les directions sont tenues (impulsion du relevé ou répétition
+    // en cours) ; tir, pause... restent des appuis
+    ButtonMask pressed = input->held;
+    input->held = 0;
+    for (int b = 0; b <= BTN_DOWN; b++)
+        if (is_direction((KEY_BOUTONS)b) && ((pressed & BTN_MASK(b)) || hold_until_ns[b] > now))
+            input->held |= BTN_MASK(b);
+}
+
+static void draw_menu_items(int mid_y, const char *const items[4], int selection)
+{
+    for (int i = 0; i < 4; ++i)
+        put_centered(mid_y + i, items[i], i == selection ? A_REVERSE : 0);
+}
+
 static void ncurses_render(const GameModel *model)
 {
-    clear();
+    int rows, cols;
+    getmaxyx(stdscr, rows, cols);
+    if (resize_pending || (rows > 1 ? rows - 1 : 1) != grid_rows || cols != grid_cols)
+        layout_init();
+
+    for (int i = 0; i < grid_rows * grid_cols; i++)
+    {
+        cells_back[i] = ' ';
+        cells_prio[i] = TERM_PRIO_LOW;
+    }
 
     int tx, ty;
+    Entity e;
 
-    // 1. Dessiner le Joueur
+    // 0. Explosions, sous tout le reste : premières sacrifiées en débit limité
+    draw_prio = TERM_PRIO_LOW;
+    for (int i = 0; i < EXPLOSION_MAX; i++)
+    {
+        if (model_get_explosion(model, i, &e))
+        {
+            transform_coords(e.x + e.width / 2, e.y + e.height / 2, &tx, &ty);
+            put_cell(tx, ty, '#');
+        }
+    }
+
+    // 1. Dessiner le Joueur (absent pendant le délai de réapparition)
+    draw_prio = TERM_PRIO_HIGH;
     transform_coords(model->player.x, model->player.y, &tx, &ty);
-    mvaddch(ty, tx, 'A' | A_BOLD);
+    if (model->player.active)
+        put_cell(tx, ty, 'A' | A_BOLD);
 
     // Afficher le bouclier si actif
-    if (model->player.shield)
+    if (model->player.active && model->player.shield)
     {
-        mvaddch(ty - 1, tx, 'O');
-        mvaddch(ty + 1, tx, 'O');
-        mvaddch(ty, tx - 1, 'O');
-        mvaddch(ty, tx + 1, 'O');
+        put_cell(tx, ty - 1, 'O');
+        put_cell(tx, ty + 1, 'O');
+        put_cell(tx - 1, ty, 'O');
+        put_cell(tx + 1, ty, 'O');
     }
 
     // 2. Dessiner le BOSS (si actif)
+    draw_prio = TERM_PRIO_NORMAL;
     if (model->boss.active)
     {
+        char boss[32];
         transform_coords(model->boss.x + model->boss.width / 2, model->boss.y + model->boss.height / 2, &tx, &ty);
-        mvprintw(ty, tx, "[ BOSS (%d) ]", model->boss.hp);
+        snprintf(boss, sizeof(boss), "[ BOSS (%d) ]", model->boss.hp);
+        put_text(tx, ty, boss, 0);
     }
     else
     {
         // Dessiner les Aliens (seulement si pas de boss)
         for (int i = 0; i < MAX_ALIENS; i++)
         {
-            if (model->aliens[i].active)
+            if (model_get_alien(model, i, &e))
             {
-                transform_coords(model->aliens[i].x, model->aliens[i].y, &tx, &ty);
-                mvaddch(ty, tx, '@');
+                transform_coords(e.x, e.y, &tx, &ty);
+                put_cell(tx, ty, '@');
             }
         }
     }
@@ -101,80 +433,120 @@ static void ncurses_render(const GameModel *model)
     // 3. Dessiner les Balles
     for (int i = 0; i < MAX_BULLETS; i++)
     {
-        if (model->bullets[i].active)
+        if (model_get_bullet(model, i, &e))
         {
-            transform_coords(model->bullets[i].x, model->bullets[i].y, &tx, &ty);
+            transform_coords(e.x, e.y, &tx, &ty);
             char c = '|';
-            if (model->bullets[i].type == ENTITY_BULLET_BOSS)
+            if (e.type == ENTITY_BULLET_BOSS)
                 c = '!'; // Balle de boss
-            mvaddch(ty, tx, c);
+            put_cell(tx, ty, c);
         }
     }
 
     // Dessiner les items
     for (int i = 0; i < ITEMS_MAX; i++)
     {
-        if (model->items[i].active)
+        if (model_get_item(model, i, &e))
         {
-            transform_coords(model->items[i].x, model->items[i].y, &tx, &ty);
-            mvaddch(ty, tx, '*');
+            transform_coords(e.x, e.y, &tx, &ty);
+            put_cell(tx, ty, '*');
         }
     }
 
-    // Infos
-    mvprintw(0, 0, "Score: %d  Vies: %d  Level: %d", model->score, model->lives, model->level);
-
-    // Menu / Pause
+    // Menu / Pause (centrés sur l'écran entier, HUD compris)
+    draw_prio = TERM_PRIO_HIGH;
     if (model->menu_mode != 0)
     {
-        int mid_y = LINES / 2 + 4;
-        int mid_x = COLS / 2;
+        int mid_y = grid_rows / 2 + 3;
         if (model->menu_mode == 1)
         {
-            const char *title = "=== SPACE INVADERS ===";
-            mvprintw(mid_y - 2, mid_x - (int)strlen(title) / 2, "%s", title);
-            const char *items[] = {"Start Game", "Settings", "High Scores", "Quit"};
-            for (int i = 0; i < 4; ++i)
-            {
-                int tx = mid_x - (int)strlen(items[i]) / 2;
-                if (i == model->menu_selection)
-                    attron(A_REVERSE);
-                mvprintw(mid_y + i, tx, "%s", items[i]);
-                if (i == model->menu_selection)
-                    attroff(A_REVERSE);
-            }
+            static const char *const items[] = {"Start Game", "Settings", "High Scores", "Quit"};
+            put_centered(mid_y - 2, "=== SPACE INVADERS ===", 0);
+            draw_menu_items(mid_y, items, model->menu_selection);
         }
         else if (model->menu_mode == 2)
         {
-            const char *s = "SETTINGS - Press ESC to return";
-            mvprintw(mid_y, mid_x - (int)strlen(s) / 2, "%s", s);
+            put_centered(mid_y, "SETTINGS - Press ESC to return", 0);
         }
         else if (model->menu_mode == 3)
         {
             char buf[64];
             snprintf(buf, sizeof(buf), "HIGH SCORE: %d", model->high_score);
-            mvprintw(mid_y, mid_x - (int)strlen(buf) / 2, "%s", buf);
-            const char *r = "Press ESC to return";
-            mvprintw(mid_y + 1, mid_x - (int)strlen(r) / 2, "%s", r);
+            put_centered(mid_y, buf, 0);
+            put_centered(mid_y + 1, "Press ESC to return", 0);
         }
         else if (model->menu_mode == 4)
         {
-            const char *p = "PAUSED";
-            mvprintw(mid_y - 2, mid_x - (int)strlen(p) / 2, "%s", p);
-            const char *items[] = {"Resume", "Settings", "High Scores", "Quit"};
-            for (int i = 0; i < 4; ++i)
-            {
-                int tx = mid_x - (int)strlen(items[i]) / 2;
-                if (i == model->menu_selection)
-                    attron(A_REVERSE);
-                mvprintw(mid_y + i, tx, "%s", items[i]);
-                if (i == model->menu_selection)
-                    attroff(A_REVERSE);
-            }
+            static const char *const items[] = {"Resume", "Settings", "High Scores", "Quit"};
+            put_centered(mid_y - 2, "PAUSED", 0);
+            draw_menu_items(mid_y, items, model->menu_selection);
+            put_centered(mid_y + 5, "<- / -> : rewind", 0);
+        }
+    }
+
+    if (show_perf)
+    {
+        char lines[PERF_LINES][PERF_LINE_LEN];
+        int count = perf_overlay_lines(model, lines);
+        for (int i = 0; i < count; i++)
+        {
+            char line[PERF_LINE_LEN + 1];
+            snprintf(line, sizeof(line), "%-*s", PERF_LINE_LEN - 1, lines[i]);
+            put_text(grid_cols - PERF_LINE_LEN, i, line, 0);
         }
     }
 
-    refresh();
+    char hud[sizeof(hud_text)];
+    snprintf(hud, sizeof(hud), "Score: %d  Vies: %d  Level: %d", model->score, model->lives, model->level);
+
+    if (bandwidth)
+    {
+        // Dépôt sans attente : le thread de sortie écrira quand il pourra
+        PERF_BEGIN(PERF_PRESENT);
+        term_out_post(cells_back, cells_prio, hud);
+        PERF_END(PERF_PRESENT);
+        uint64_t sent = term_out_stats().bytes;
+        PERF_OUTPUT_BYTES((long long)(sent - out_last_bytes));
+        out_last_bytes = sent;
+        return;
+    }
+
+    int changed = flush_cells();
+
+    // Infos : fenêtre du HUD, réécrite seulement si le texte change
+    if (strcmp(hud, hud_text) != 0)
+    {
+        werase(hud_win);
+        mvwaddnstr(hud_win, 0, 0, hud, grid_cols);
+        wnoutrefresh(hud_win);
+        strcpy(hud_text, hud);
+    }
+    if (changed)
+        wnoutrefresh(play_win);
+
+    PERF_BEGIN(PERF_PRESENT);
+    long long before = written_bytes();
+    doupdate();
+    long long after = written_bytes();
+    PERF_END(PERF_PRESENT);
+
+    frames_total++;
+    cells_total += (uint64_t)changed;
+    if (before >= 0 && after >= before)
+    {
+        long long bytes = after - before;
+        bytes_total += (uint64_t)bytes;
+        if (bytes > bytes_max)
+            bytes_max = bytes;
+        PERF_OUTPUT_BYTES(bytes);
+    }
+}
+
+// Pas de son en mode terminal
+static void ncurses_handle_events(const ModelEvent *events, int count)
+{
+    (void)events;
+    (void)count;
 }
 
 // Fonction publique pour récupérer l'interface
@@ -185,14 +557,6 @@ GameView view_ncurses_get_interface(void)
     v.close = ncurses_close;
     v.render = ncurses_render;
     v.get_input = ncurses_get_input;
+    v.handle_events = ncurses_handle_events;
     return v;
 }
-
-void play_item_sound(void) __attribute__((weak));
-void play_item_sound(void) {}
-
-void play_explosion_sound(void) __attribute__((weak));
-void play_explosion_sound(void) {}
-
-void play_shoot_sound(void) __attribute__((weak));
-void play_shoot_sound(void) {}
\ No newline at end of file
@@ -30,6 +30,10 @@
 #include <signal.h>
 #include <sys/wait.h>
 #include "controller.h"
+#include "audio.h"
+#include "starfield.h"
+#include "perf.h"
+#include "trace.h"
 
 // --- CONFIGURATION ---
 #define EXPLOSION_NB_FRAMES 6
@@ -37,125 +41,360 @@
 #define EXPLOSION_SCALE 1.5f
 #define SHIELD_PADDING 45
 
-#define MAX_STARS 200
-#define STAR_SPEED_MIN 0.5f
-#define STAR_SPEED_MAX 3.0f
+#define MAX_STARS 2000
+
+static Starfield stars; // flux aléatoire séparé : le décor ne touche pas à celui du jeu
+static uint64_t last_render_ns = 0;
+
+static SDL_Window *window = NULL;
+static SDL_Renderer *renderer = NULL;
+
+// Atlas : tous les sprites dans une seule texture, coordonnées UV précalculées
+typedef enum
+{
+    SPRITE_PLAYER,
+    SPRITE_ALIEN,
+    SPRITE_BOSS,
+    SPRITE_BULLET,
+    SPRITE_ITEM,
+    SPRITE_SHIELD,
+    SPRITE_EXPLOSION, // EXPLOSION_NB_FRAMES images consécutives
+    SPRITE_WHITE = SPRITE_EXPLOSION + EXPLOSION_NB_FRAMES, // texel blanc pour les rectangles unis
+    SPRITE_COUNT
+} SpriteId;
 
 typedef struct
 {
-    float x, y;
-    float speed;
-    int brightness;
-} Star;
+    float u0, v0, u1, v1;
+    bool loaded; // false : image absente, on dessine un rectangle de couleur
+} AtlasRect;
 
-static Star stars[MAX_STARS];
+static SDL_Texture *tex_atlas = NULL;
+static AtlasRect atlas[SPRITE_COUNT];
 
-static SDL_Window *window = NULL;
-static SDL_Renderer *renderer = NULL;
+// Lot de quads envoyé en un seul SDL_RenderGeometry
+#define BATCH_MAX_QUADS 256
+static SDL_Vertex batch_vertices[BATCH_MAX_QUADS * 4];
+static int batch_indices[BATCH_MAX_QUADS * 6];
+static int batch_quads = 0;
+
+// Appels de dessin envoyés au renderer, par image
+static int frame_draw_calls = 0;
+static int max_draw_calls = 0;
+static uint64_t total_draw_calls = 0;
+static uint64_t frames_drawn = 0;
 
-// Textures
-static SDL_Texture *tex_player = NULL;
-static SDL_Texture *tex_alien = NULL;
-static SDL_Texture *tex_boss = NULL; 
-static SDL_Texture *tex_bullet = NULL;
-static SDL_Texture *tex_explosion = NULL;
-static SDL_Texture *tex_items = NULL;
-static SDL_Texture *tex_bouclier = NULL;
+static bool show_perf = false; // overlay de performance (F3)
 
 // Police
 static TTF_Font *font = NULL;
 
+// Cache des textes rendus (LRU) : clé = chaîne + couleur. Le HUD ne change
+// que quand score, vies ou niveau changent ; les menus sont fixes.
+#define TEXT_CACHE_SIZE 48
+#define TEXT_CACHE_KEY 64
+
+typedef struct
+{
+    uint32_t hash;
+    char text[TEXT_CACHE_KEY];
+    SDL_Color color;
+    SDL_Texture *texture; // NULL = entrée libre
+    float w, h;
+    uint64_t last_used;
+} TextEntry;
+
+static TextEntry text_cache[TEXT_CACHE_SIZE];
+static uint64_t text_clock = 0;
+static uint64_t text_hits = 0, text_misses = 0;
+
 #if HAVE_SDL_MIXER
 static Mix_Music *bgm = NULL;
 static Mix_Chunk *sfx_item = NULL;
 static Mix_Chunk *sfx_explosion = NULL;
 static Mix_Chunk *sfx_shoot = NULL;
+
+// Latence mesurée au post-mix : premier mixage après un déclenchement
+static SDL_Mutex *sfx_lock = NULL;
+static uint64_t sfx_trigger_ns = 0;
+static AudioLatency sfx_latency;
 #else
-static pid_t bgm_pid = 0;
+static pid_t bgm_pid = 0; // la musique MP3 reste jouée par un processus externe
+static int sfx_item = -1;
+static int sfx_explosion = -1;
+static int sfx_shoot = -1;
 #endif
 
 // --- OUTILS ---
 
-static void init_stars()
+static void update_and_draw_stars()
+{
+    uint64_t now = SDL_GetTicksNS();
+    if (last_render_ns)
+        starfield_update(&stars, (float)(now - last_render_ns) / 1e9f);
+    last_render_ns = now;
+    frame_draw_calls += starfield_draw(&stars, renderer);
+}
+
+static SDL_Surface *load_surface(const char *filename)
 {
-    for (int i = 0; i < MAX_STARS; i++)
+    char path[256];
+    snprintf(path, sizeof(path), "assets/%s", filename);
+
+    char abs_path[PATH_MAX];
+    if (realpath(path, abs_path) == NULL)
+    {
+        printf("❌ ERREUR : Fichier introuvable -> %s\n", path);
+        return NULL;
+    }
+
+    SDL_Surface *loaded = IMG_Load(abs_path);
+    if (!loaded)
     {
-        stars[i].x = rand() % GAME_WIDTH;
-        stars[i].y = rand() % GAME_HEIGHT;
-        float ratio = (float)rand() / RAND_MAX;
-        stars[i].speed = STAR_SPEED_MIN + ratio * (STAR_SPEED_MAX - STAR_SPEED_MIN);
-        stars[i].brightness = 100 + (int)(ratio * 155);
+        printf("⚠️ Erreur IMG_Load : %s\n", SDL_GetError());
+        return NULL;
     }
+
+    SDL_Surface *surface = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(loaded);
+    return surface;
 }
 
-static void update_and_draw_stars()
+// --- ATLAS DE SPRITES ---
+// Rangement en étagères : les images sont posées de gauche à droite, une
+// nouvelle étagère commence quand la largeur de l'atlas est atteinte.
+
+#define ATLAS_WIDTH 1024
+#define ATLAS_PADDING 1
+#define ATLAS_WHITE_SIZE 4
+
+static void build_atlas(void)
 {
-    for (int i = 0; i < MAX_STARS; i++)
+    static const char *files[] = {"vaisseau.png", "vaisseauEnnemie.png", "boss.png", "bullets.png",
+                                  "items.png", "bouclier.png", "explosion.png"};
+    enum { FILE_COUNT = sizeof(files) / sizeof(files[0]) };
+    SDL_Surface *images[FILE_COUNT];
+    SDL_Rect place[FILE_COUNT + 1]; // + bloc blanc
+
+    int width = ATLAS_WIDTH;
+    for (int i = 0; i < FILE_COUNT; i++)
+    {
+        images[i] = load_surface(files[i]);
+        if (images[i] && images[i]->w + 2 * ATLAS_PADDING > width)
+            width = images[i]->w + 2 * ATLAS_PADDING;
+    }
+
+    int x = ATLAS_PADDING, y = ATLAS_PADDING, shelf_h = 0;
+    for (int i = 0; i <= FILE_COUNT; i++)
     {
-        stars[i].y += stars[i].speed;
-        if (stars[i].y > GAME_HEIGHT)
+        int w = ATLAS_WHITE_SIZE, h = ATLAS_WHITE_SIZE;
+        if (i < FILE_COUNT)
         {
-            stars[i].y = 0;
-            stars[i].x = rand() % GAME_WIDTH;
+            if (!images[i])
+                continue;
+            w = images[i]->w;
+            h = images[i]->h;
         }
-        SDL_SetRenderDrawColor(renderer, stars[i].brightness, stars[i].brightness, stars[i].brightness, 255);
-        SDL_RenderPoint(renderer, stars[i].x, stars[i].y);
-        if (stars[i].speed > 2.0f)
+        if (x + w + ATLAS_PADDING > width)
         {
-            SDL_RenderPoint(renderer, stars[i].x + 1, stars[i].y);
-            SDL_RenderPoint(renderer, stars[i].x, stars[i].y + 1);
-            SDL_RenderPoint(renderer, stars[i].x + 1, stars[i].y + 1);
+            x = ATLAS_PADDING;
+            y += shelf_h + ATLAS_PADDING;
+            shelf_h = 0;
         }
+        place[i] = (SDL_Rect){x, y, w, h};
+        x += w + ATLAS_PADDING;
+        if (h > shelf_h)
+            shelf_h = h;
+    }
+    int height = y + shelf_h + ATLAS_PADDING;
+
+    SDL_Surface *sheet = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+    if (sheet)
+    {
+        SDL_FillSurfaceRect(sheet, NULL, 0);
+        SDL_FillSurfaceRect(sheet, &place[FILE_COUNT], 0xFFFFFFFF);
+        for (int i = 0; i < FILE_COUNT; i++)
+        {
+            if (!images[i])
+                continue;
+            SDL_SetSurfaceBlendMode(images[i], SDL_BLENDMODE_NONE); // copie brute, alpha compris
+            SDL_BlitSurface(images[i], NULL, sheet, &place[i]);
+        }
+        tex_atlas = SDL_CreateTextureFromSurface(renderer, sheet);
+        SDL_DestroySurface(sheet);
+    }
+    if (tex_atlas)
+    {
+        SDL_SetTextureScaleMode(tex_atlas, SDL_SCALEMODE_NEAREST);
+        SDL_SetTextureBlendMode(tex_atlas, SDL_BLENDMODE_BLEND);
+    }
+
+    // UV : une entrée par sprite, l'explosion est découpée en ses images
+    for (int i = 0; i < FILE_COUNT; i++)
+    {
+        int frames = (i == SPRITE_EXPLOSION) ? EXPLOSION_NB_FRAMES : 1;
+        for (int f = 0; f < frames; f++)
+        {
+            AtlasRect *r = &atlas[i + f];
+            r->loaded = tex_atlas && images[i];
+            if (!r->loaded)
+                continue;
+            float fw = (float)place[i].w / frames;
+            r->u0 = (place[i].x + f * fw) / width;
+            r->u1 = (place[i].x + (f + 1) * fw) / width;
+            r->v0 = (float)place[i].y / height;
+            r->v1 = (float)(place[i].y + place[i].h) / height;
+        }
+        if (images[i])
+            SDL_DestroySurface(images[i]);
+    }
+
+    // Rectangles unis : on échantillonne le centre du bloc blanc
+    float wu = (place[FILE_COUNT].x + ATLAS_WHITE_SIZE / 2.0f) / width;
+    float wv = (place[FILE_COUNT].y + ATLAS_WHITE_SIZE / 2.0f) / height;
+    atlas[SPRITE_WHITE] = (AtlasRect){wu, wv, wu, wv, true};
+
+    // Index des quads, toujours les mêmes : 0-1-2, 2-3-0
+    for (int q = 0; q < BATCH_MAX_QUADS; q++)
+    {
+        static const int quad[6] = {0, 1, 2, 2, 3, 0};
+        for (int k = 0; k < 6; k++)
+            batch_indices[q * 6 + k] = q * 4 + quad[k];
     }
+
+    if (tex_atlas)
+        printf("🖼️ Atlas de sprites : %dx%d\n", width, height);
 }
 
-static SDL_Texture *load_texture(const char *filename)
+static void batch_flush(void)
 {
-    char path[256];
-    snprintf(path, sizeof(path), "assets/%s", filename);
+    if (batch_quads == 0)
+        return;
+    // Sans texture, SDL_RenderGeometry suit le mode de mélange du renderer
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_RenderGeometry(renderer, tex_atlas, batch_vertices, batch_quads * 4, batch_indices, batch_quads * 6);
+    frame_draw_calls++;
+    batch_quads = 0;
+}
 
-    char abs_path[PATH_MAX];
-    if (realpath(path, abs_path) == NULL)
+static void batch_quad(const SDL_FRect *dst, const AtlasRect *uv, SDL_Color color)
+{
+    if (batch_quads == BATCH_MAX_QUADS)
+        batch_flush();
+    SDL_FColor c = {color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f};
+    SDL_Vertex *v = &batch_vertices[batch_quads * 4];
+    v[0] = (SDL_Vertex){{dst->x, dst->y}, c, {uv->u0, uv->v0}};
+    v[1] = (SDL_Vertex){{dst->x + dst->w, dst->y}, c, {uv->u1, uv->v0}};
+    v[2] = (SDL_Vertex){{dst->x + dst->w, dst->y + dst->h}, c, {uv->u1, uv->v1}};
+    v[3] = (SDL_Vertex){{dst->x, dst->y + dst->h}, c, {uv->u0, uv->v1}};
+    batch_quads++;
+}
+
+// Sprite de l'atlas, ou rectangle de la couleur de secours si l'image manque
+static void batch_sprite(const SDL_FRect *dst, SpriteId sprite, SDL_Color fallback)
+{
+    if (atlas[sprite].loaded)
+        batch_quad(dst, &atlas[sprite], (SDL_Color){255, 255, 255, 255});
+    else
+        batch_quad(dst, &atlas[SPRITE_WHITE], fallback);
+}
+
+static void batch_rect(const SDL_FRect *dst, SDL_Color color)
+{
+    batch_quad(dst, &atlas[SPRITE_WHITE], color);
+}
+
+// --- FONCTIONS DESSIN TEXTE AMÉLIORÉES (AVEC FALLBACK) ---
+
+static uint32_t text_hash(const char *text, SDL_Color color)
+{
+    uint32_t h = 2166136261u; // FNV-1a
+    for (const char *c = text; *c; c++)
+        h = (h ^ (uint8_t)*c) * 16777619u;
+    h = (h ^ color.r) * 16777619u;
+    h = (h ^ color.g) * 16777619u;
+    h = (h ^ color.b) * 16777619u;
+    return (h ^ color.a) * 16777619u;
+}
+
+// Texture du texte, rendue une seule fois tant qu'elle reste dans le cache.
+// NULL si le rendu échoue. Les chaînes trop longues pour la clé ne sont pas
+// gardées : *owned indique à l'appelant qu'il doit détruire la texture.
+static SDL_Texture *text_texture(const char *text, SDL_Color color, float *w, float *h, bool *owned)
+{
+    size_t len = strlen(text);
+    *owned = len >= TEXT_CACHE_KEY;
+    uint32_t hash = text_hash(text, color);
+    text_clock++;
+
+    TextEntry *slot = &text_cache[0];
+    if (!*owned)
     {
-        printf("❌ ERREUR : Fichier introuvable -> %s\n", path);
-        return NULL;
+        for (int i = 0; i < TEXT_CACHE_SIZE; i++)
+        {
+            TextEntry *entry = &text_cache[i];
+            if (entry->texture && entry->hash == hash && memcmp(&entry->color, &color, sizeof(color)) == 0 &&
+                strcmp(entry->text, text) == 0)
+            {
+                entry->last_used = text_clock;
+                *w = entry->w;
+                *h = entry->h;
+                text_hits++;
+                return entry->texture;
+            }
+            // Victime : entrée libre, sinon la moins récemment utilisée
+            if (slot->texture && (!entry->texture || entry->last_used < slot->last_used))
+                slot = entry;
+        }
     }
+    text_misses++;
 
-    SDL_Surface *surface = IMG_Load(abs_path);
+    SDL_Surface *surface = TTF_RenderText_Solid(font, text, len, color);
     if (!surface)
-    {
-        printf("⚠️ Erreur IMG_Load : %s\n", SDL_GetError());
         return NULL;
-    }
-
     SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (texture)
-        SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+    *w = (float)surface->w;
+    *h = (float)surface->h;
     SDL_DestroySurface(surface);
+    if (!texture || *owned)
+        return texture;
+
+    if (slot->texture)
+        SDL_DestroyTexture(slot->texture);
+    *slot = (TextEntry){hash, "", color, texture, *w, *h, text_clock};
+    memcpy(slot->text, text, len + 1);
     return texture;
 }
 
-// --- FONCTIONS DESSIN TEXTE AMÉLIORÉES (AVEC FALLBACK) ---
+static void text_cache_clear(void)
+{
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++)
+    {
+        if (text_cache[i].texture)
+            SDL_DestroyTexture(text_cache[i].texture);
+        text_cache[i].texture = NULL;
+    }
+    if (text_hits + text_misses)
+        printf("🔤 Cache texte : %.1f%% de textes réutilisés (%llu rendus)\n",
+               100.0 * text_hits / (text_hits + text_misses), (unsigned long long)text_misses);
+    text_hits = text_misses = 0;
+}
 
 static void draw_text_internal(const char *text, float x, float y, SDL_Color color, bool centered, float fallback_scale)
 {
     if (font)
     {
-        SDL_Surface *surface = TTF_RenderText_Solid(font, text, strlen(text), color);
-        if (surface)
+        SDL_FRect dest_rect;
+        bool owned;
+        SDL_Texture *texture = text_texture(text, color, &dest_rect.w, &dest_rect.h, &owned);
+        if (texture)
         {
-            SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-            if (texture)
-            {
-                SDL_FRect dest_rect;
-                dest_rect.w = (float)surface->w;
-                dest_rect.h = (float)surface->h;
-                dest_rect.x = centered ? (x - dest_rect.w / 2.0f) : x;
-                dest_rect.y = y;
-                SDL_RenderTexture(renderer, texture, NULL, &dest_rect);
+            dest_rect.x = centered ? (x - dest_rect.w / 2.0f) : x;
+            dest_rect.y = y;
+            SDL_RenderTexture(renderer, texture, NULL, &dest_rect);
+            frame_draw_calls++;
+            if (owned)
                 SDL_DestroyTexture(texture);
-            }
-            SDL_DestroySurface(surface);
         }
     }
     else
@@ -171,6 +410,7 @@ static void draw_text_internal(const char *text, float x, float y, SDL_Color col
         float final_x = centered ? (x - text_w / 2.0f) : x;
 
         SDL_RenderDebugText(renderer, final_x / fallback_scale, y / fallback_scale, text);
+        frame_draw_calls++;
 
         SDL_SetRenderScale(renderer, old_sx, old_sy);
     }
@@ -186,39 +426,30 @@ static void draw_text_centered(const char *text, float center_x, float y, SDL_Co
     draw_text_internal(text, center_x, y, color, true, 3.0f);
 }
 
-// --- SYSTEME AUDIO FALLBACK ---
-static void play_sound_fallback(const char *filename)
+#if HAVE_SDL_MIXER
+static void sfx_postmix(void *udata, Uint8 *stream, int len)
 {
-    char path[PATH_MAX];
-    if (realpath(filename, path) == NULL)
-        return;
-
-    pid_t pid = fork();
-    if (pid == 0)
+    (void)udata;
+    (void)stream;
+    (void)len;
+    SDL_LockMutex(sfx_lock);
+    if (sfx_trigger_ns)
     {
-        freopen("/dev/null", "w", stdout);
-        freopen("/dev/null", "w", stderr);
-#if defined(__APPLE__)
-        execlp("afplay", "afplay", path, (char *)NULL);
-#else
-        if (strstr(path, ".mp3") || strstr(path, ".MP3"))
-        {
-            execlp("mpg123", "mpg123", "-q", path, (char *)NULL);
-        }
-        else
-        {
-            execlp("aplay", "aplay", "-q", path, (char *)NULL);
-        }
-#endif
-        _exit(1);
+        audio_latency_add(&sfx_latency, SDL_GetTicksNS() - sfx_trigger_ns +
+                                            (uint64_t)audio_get_buffer_frames() * 1000000000ull / AUDIO_FREQ);
+        sfx_trigger_ns = 0;
     }
+    SDL_UnlockMutex(sfx_lock);
 }
+#endif
 
 static void sdl_init(void)
 {
+    TRACE_BEGIN("sdl_init");
     if (!SDL_Init(SDL_INIT_VIDEO))
     {
         fprintf(stderr, "Erreur SDL_Init: %s\n", SDL_GetError());
+        TRACE_END("sdl_init");
         return;
     }
 
@@ -227,30 +458,35 @@ static void sdl_init(void)
         fprintf(stderr, "⚠️ Erreur TTF_Init: %s\n", SDL_GetError());
     }
 
+    TRACE_BEGIN("audio_open");
 #if HAVE_SDL_MIXER
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0)
+    if (Mix_OpenAudio(AUDIO_FREQ, MIX_DEFAULT_FORMAT, AUDIO_CHANNELS, audio_get_buffer_frames()) < 0)
     {
         printf("⚠️ Erreur SDL_Mixer Init: %s. Passage en mode audio dégradé.\n", Mix_GetError());
     }
     else
     {
-        printf("🔊 Audio initialisé avec SDL_Mixer.\n");
+        printf("🔊 Audio initialisé avec SDL_Mixer (tampon %d échantillons).\n", audio_get_buffer_frames());
+        sfx_lock = SDL_CreateMutex();
+        sfx_latency = (AudioLatency){0, 0, 0};
+        Mix_SetPostMix(sfx_postmix, NULL);
     }
+#else
+    audio_init();
 #endif
+    TRACE_END("audio_open");
 
     window = SDL_CreateWindow("Star Launcher", GAME_WIDTH, GAME_HEIGHT, 0);
     renderer = SDL_CreateRenderer(window, NULL);
 
-    tex_player = load_texture("vaisseau.png");
-    tex_alien = load_texture("vaisseauEnnemie.png");
-    tex_bullet = load_texture("bullets.png");
-    tex_explosion = load_texture("explosion.png");
-    tex_items = load_texture("items.png");
-    tex_bouclier = load_texture("bouclier.png");
-    tex_boss = load_texture("boss.png");
+    TRACE_BEGIN("load_sprites");
+    build_atlas();
+    TRACE_END("load_sprites");
 
-    init_stars();
+    starfield_init(&stars, MAX_STARS, GAME_WIDTH, GAME_HEIGHT, SDL_GetTicksNS(), RNG_STREAM_STARS);
+    last_render_ns = 0;
 
+    TRACE_BEGIN("load_font");
     char font_path[PATH_MAX];
     if (realpath("assets/font.ttf", font_path))
         font = TTF_OpenFont(font_path, 24.0f);
@@ -259,6 +495,9 @@ static void sdl_init(void)
 
     if (!font)
         printf("⚠️ INFO: Police non trouvée. Mode texte de secours activé.\n");
+    TRACE_END("load_font");
+
+    TRACE_BEGIN("load_sounds");
 
 #if HAVE_SDL_MIXER
     char path[PATH_MAX];
@@ -275,9 +514,16 @@ static void sdl_init(void)
     if (realpath("assets/explosionaudio.WAV", path))
         sfx_explosion = Mix_LoadWAV(path);
 #else
+    char path[PATH_MAX];
+    if (realpath("assets/alarme6.WAV", path))
+        sfx_item = audio_load(path);
+    if (realpath("assets/tielaser.WAV", path))
+        sfx_shoot = audio_load(path);
+    if (realpath("assets/explosionaudio.WAV", path))
+        sfx_explosion = audio_load(path);
+
     if (bgm_pid == 0)
     {
-        char path[PATH_MAX];
         if (realpath("assets/background.mp3", path))
         {
             pid_t pid = fork();
@@ -299,27 +545,24 @@ static void sdl_init(void)
         }
     }
 #endif
-
-    model_set_audio_callbacks(play_item_sound, play_explosion_sound, play_shoot_sound);
+    TRACE_END("load_sounds");
+    TRACE_END("sdl_init");
 }
 
 static void sdl_close(void)
 {
-    if (tex_player)
-        SDL_DestroyTexture(tex_player);
-    if (tex_alien)
-        SDL_DestroyTexture(tex_alien);
-    if (tex_boss)
-        SDL_DestroyTexture(tex_boss);
-    if (tex_bullet)
-        SDL_DestroyTexture(tex_bullet);
-    if (tex_explosion)
-        SDL_DestroyTexture(tex_explosion);
-    if (tex_items)
-        SDL_DestroyTexture(tex_items);
-    if (tex_bouclier)
-        SDL_DestroyTexture(tex_bouclier);
-
+    if (tex_atlas)
+        SDL_DestroyTexture(tex_atlas);
+    tex_atlas = NULL;
+
+    if (frames_drawn)
+        printf("🖼️ Appels de dessin : moy %.1f par image, max %d (%llu images)\n",
+               (double)total_draw_calls / frames_drawn, max_draw_calls, (unsigned long long)frames_drawn);
+    frames_drawn = total_draw_calls = 0;
+    max_draw_calls = 0;
+
+    starfield_free(&stars);
+    text_cache_clear();
     if (font)
         TTF_CloseFont(font);
 
@@ -332,8 +575,17 @@ static void sdl_close(void)
         Mix_FreeChunk(sfx_explosion);
     if (sfx_shoot)
         Mix_FreeChunk(sfx_shoot);
+    Mix_SetPostMix(NULL, NULL);
     Mix_CloseAudio();
+    if (sfx_lock)
+    {
+        SDL_DestroyMutex(sfx_lock);
+        sfx_lock = NULL;
+        audio_latency_print("SDL_mixer", &sfx_latency);
+    }
 #else
+    audio_close();
+    sfx_item = sfx_explosion = sfx_shoot = -1;
     if (bgm_pid > 0)
     {
         kill(bgm_pid, SIGTERM);
@@ -348,41 +600,78 @@ static void sdl_close(void)
     SDL_Quit();
 }
 
-static KEY_BOUTONS sdl_get_input(void)
+// Touches du jeu (plusieurs touches peuvent donner le même bouton)
+static const struct
+{
+    SDL_Scancode scancode;
+    KEY_BOUTONS button;
+} key_map[] = {
+    {SDL_SCANCODE_ESCAPE, BTN_QUIT},
+    {SDL_SCANCODE_SPACE, BTN_FIRE},
+    {SDL_SCANCODE_RETURN, BTN_SELECT},
+    {SDL_SCANCODE_KP_ENTER, BTN_SELECT},
+    {SDL_SCANCODE_P, BTN_PAUSE},
+    {SDL_SCANCODE_LEFT, BTN_LEFT},
+    {SDL_SCANCODE_RIGHT, BTN_RIGHT},
+    {SDL_SCANCODE_UP, BTN_UP},
+    {SDL_SCANCODE_DOWN, BTN_DOWN},
+};
+#define KEY_MAP_COUNT (int)(sizeof(key_map) / sizeof(key_map[0]))
+
+static KEY_BOUTONS scancode_to_button(SDL_Scancode sc)
+{
+    for (int i = 0; i < KEY_MAP_COUNT; i++)
+        if (key_map[i].scancode == sc)
+            return key_map[i].button;
+    return BTN_NONE;
+}
+
+// Appuis depuis les événements, boutons tenus depuis l'état du clavier.
+// La répétition du clavier ne compte que pour les flèches (menus, rembobinage)
+static void sdl_get_input(InputState *input)
 {
+    *input = (InputState){0};
     SDL_Event event;
     while (SDL_PollEvent(&event))
     {
         if (event.type == SDL_EVENT_QUIT)
-            return BTN_QUIT;
+            input_press(input, BTN_QUIT);
 
-        if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN)
+        if (event.type == SDL_EVENT_KEY_DOWN)
         {
-            if (event.button.button == SDL_BUTTON_LEFT)
-            {
-                return BTN_SELECT;
-            }
+            if (event.key.key == SDLK_F3 && !event.key.repeat)
+                show_perf = !show_perf;
+            KEY_BOUTONS btn = scancode_to_button(event.key.scancode);
+            bool arrow = btn == BTN_LEFT || btn == BTN_RIGHT || btn == BTN_UP || btn == BTN_DOWN;
+            if (btn != BTN_NONE && (!event.key.repeat || arrow))
+                input_press(input, btn);
         }
+
+        if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN && event.button.button == SDL_BUTTON_LEFT)
+            input_press(input, BTN_SELECT);
     }
 
     const bool *state = SDL_GetKeyboardState(NULL);
-    if (state[SDL_SCANCODE_ESCAPE])
-        return BTN_QUIT;
-    if (state[SDL_SCANCODE_SPACE])
-        return BTN_FIRE;
-    if (state[SDL_SCANCODE_RETURN] || state[SDL_SCANCODE_KP_ENTER])
-        return BTN_SELECT;
-    if (state[SDL_SCANCODE_P])
-        return BTN_PAUSE;
-    if (state[SDL_SCANCODE_LEFT])
-        return BTN_LEFT;
-    if (state[SDL_SCANCODE_RIGHT])
-        return BTN_RIGHT;
-    if (state[SDL_SCANCODE_UP])
-        return BTN_UP;
-    if (state[SDL_SCANCODE_DOWN])
-        return BTN_DOWN;
-    return BTN_NONE;
+    for (int i = 0; i < KEY_MAP_COUNT; i++)
+        if (state[key_map[i].scancode])
+            input->held |= BTN_MASK(key_map[i].button);
+}
+
+static void draw_perf_overlay(const GameModel *model)
+{
+    char lines[PERF_LINES][PERF_LINE_LEN];
+    int count = perf_overlay_lines(model, lines);
+    if (count == 0)
+        return;
+
+    const float line_h = font ? 26.0f : 20.0f;
+    SDL_FRect box = {GAME_WIDTH - 470.0f, 50.0f, 460.0f, count * line_h + 10.0f};
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+    SDL_RenderFillRect(renderer, &box);
+    frame_draw_calls++;
+    for (int i = 0; i < count; i++)
+        draw_text(lines[i], box.x + 8.0f, box.y + 5.0f + i * line_h, (SDL_Color){0, 255, 120, 255});
 }
 
 static void sdl_render(const GameModel *model)
@@ -390,11 +679,16 @@ static void sdl_render(const GameModel *model)
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
 
+    TRACE_BEGIN("stars");
     update_and_draw_stars();
+    TRACE_END("stars");
 
     SDL_FRect rect;
 
     // --- Rendu du Jeu ---
+    TRACE_BEGIN("sprites");
+    // Tout passe par l'atlas : un seul lot de géométrie pour les entités
+    // (plus si le lot déborde), dans l'ordre d'affichage d'avant.
 
     // JOUEUR
     if (model->player.active)
@@ -403,140 +697,94 @@ static void sdl_render(const GameModel *model)
 
         if (model->player.shield)
         {
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
             SDL_FRect srect = {rect.x - SHIELD_PADDING, rect.y - SHIELD_PADDING, rect.w + SHIELD_PADDING * 2, rect.h + SHIELD_PADDING * 2};
-            if (tex_bouclier)
-                SDL_RenderTexture(renderer, tex_bouclier, NULL, &srect);
-            else
-            {
-                SDL_SetRenderDrawColor(renderer, 0, 160, 255, 100);
-                SDL_RenderFillRect(renderer, &srect);
-            }
+            batch_sprite(&srect, SPRITE_SHIELD, (SDL_Color){0, 160, 255, 100});
         }
 
-        if (tex_player)
-            SDL_RenderTexture(renderer, tex_player, NULL, &rect);
-        else
-        {
-            SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-            SDL_RenderFillRect(renderer, &rect);
-        }
+        batch_sprite(&rect, SPRITE_PLAYER, (SDL_Color){0, 255, 0, 255});
     }
 
     // BOSS
     if (model->boss.active)
     {
         rect = (SDL_FRect){model->boss.x, model->boss.y, (float)model->boss.width, (float)model->boss.height};
-        if (tex_boss)
-            SDL_RenderTexture(renderer, tex_boss, NULL, &rect);
-        else
-        {
-            // Affichage de secours (Carré Magenta) si l'image bosss.png ne charge pas
-            SDL_SetRenderDrawColor(renderer, 200, 0, 200, 255);
-            SDL_RenderFillRect(renderer, &rect);
-        }
+        // Secours : carré magenta si boss.png ne charge pas
+        batch_sprite(&rect, SPRITE_BOSS, (SDL_Color){200, 0, 200, 255});
 
         // Barre de vie du Boss
         SDL_FRect hp_bar_bg = {rect.x, rect.y - 15, rect.w, 10};
-        SDL_SetRenderDrawColor(renderer, 50, 0, 0, 255);
-        SDL_RenderFillRect(renderer, &hp_bar_bg);
+        batch_rect(&hp_bar_bg, (SDL_Color){50, 0, 0, 255});
 
         // PV max = 100 (fixe selon votre demande)
         float hp_percent = (float)model->boss.hp / 100.0f;
         SDL_FRect hp_bar_fg = {rect.x, rect.y - 15, rect.w * hp_percent, 10};
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-        SDL_RenderFillRect(renderer, &hp_bar_fg);
+        batch_rect(&hp_bar_fg, (SDL_Color){255, 0, 0, 255});
     }
 
     // ALIENS
     // Important : Ne les dessiner que s'ils sont actifs. (Normalement désactivés durant le boss)
+    Entity e;
     for (int i = 0; i < MAX_ALIENS; i++)
     {
-        if (model->aliens[i].active)
+        if (model_get_alien(model, i, &e))
         {
-            rect = (SDL_FRect){model->aliens[i].x, model->aliens[i].y, (float)model->aliens[i].width, (float)model->aliens[i].height};
-            if (tex_alien)
-                SDL_RenderTexture(renderer, tex_alien, NULL, &rect);
-            else
-            {
-                SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-                SDL_RenderFillRect(renderer, &rect);
-            }
+            rect = (SDL_FRect){e.x, e.y, (float)e.width, (float)e.height};
+            batch_sprite(&rect, SPRITE_ALIEN, (SDL_Color){255, 0, 0, 255});
         }
     }
 
     // BALLES
     for (int i = 0; i < MAX_BULLETS; i++)
     {
-        if (model->bullets[i].active)
+        if (model_get_bullet(model, i, &e))
         {
-            rect = (SDL_FRect){model->bullets[i].x, model->bullets[i].y, (float)model->bullets[i].width, (float)model->bullets[i].height};
-            if (tex_bullet)
-            {
-                // On peut varier la couleur ou la texture selon le type, ici on utilise la même
-                SDL_RenderTexture(renderer, tex_bullet, NULL, &rect);
-            }
-            else
-            {
-                if (model->bullets[i].type == ENTITY_BULLET_BOSS)
-                    SDL_SetRenderDrawColor(renderer, 255, 0, 255, 255);
-                else if (model->bullets[i].type == ENTITY_BULLET_PLAYER)
-                    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-                else
-                    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-                SDL_RenderFillRect(renderer, &rect);
-            }
+            rect = (SDL_FRect){e.x, e.y, (float)e.width, (float)e.height};
+            // Même sprite pour tous les tirs, la couleur de secours dépend du tireur
+            SDL_Color fallback = {255, 0, 0, 255};
+            if (e.type == ENTITY_BULLET_BOSS)
+                fallback = (SDL_Color){255, 0, 255, 255};
+            else if (e.type == ENTITY_BULLET_PLAYER)
+                fallback = (SDL_Color){255, 255, 0, 255};
+            batch_sprite(&rect, SPRITE_BULLET, fallback);
         }
     }
 
     // ITEMS
     for (int i = 0; i < ITEMS_MAX; i++)
     {
-        if (model->items[i].active)
+        if (model_get_item(model, i, &e))
         {
-            rect = (SDL_FRect){model->items[i].x, model->items[i].y, (float)model->items[i].width, (float)model->items[i].height};
-            if (tex_items)
-                SDL_RenderTexture(renderer, tex_items, NULL, &rect);
-            else
-            {
-                SDL_SetRenderDrawColor(renderer, 0, 255, 255, 255);
-                SDL_RenderFillRect(renderer, &rect);
-            }
+            rect = (SDL_FRect){e.x, e.y, (float)e.width, (float)e.height};
+            batch_sprite(&rect, SPRITE_ITEM, (SDL_Color){0, 255, 255, 255});
         }
     }
 
     // EXPLOSIONS
     for (int i = 0; i < EXPLOSION_MAX; i++)
     {
-        if (model->explosions[i].active)
+        if (model_get_explosion(model, i, &e))
         {
-            float cx = model->explosions[i].x + model->explosions[i].width / 2.0f;
-            float cy = model->explosions[i].y + model->explosions[i].height / 2.0f;
-            float dw = model->explosions[i].width * EXPLOSION_SCALE;
-            float dh = model->explosions[i].height * EXPLOSION_SCALE;
+            float cx = e.x + e.width / 2.0f;
+            float cy = e.y + e.height / 2.0f;
+            float dw = e.width * EXPLOSION_SCALE;
+            float dh = e.height * EXPLOSION_SCALE;
             rect = (SDL_FRect){cx - dw / 2.0f, cy - dh / 2.0f, dw, dh};
 
-            if (tex_explosion)
-            {
-                float p = 1.0f - (model->explosions[i].dx / EXPLOSION_DURATION);
-                int idx = (int)(p * EXPLOSION_NB_FRAMES);
-                if (idx >= EXPLOSION_NB_FRAMES)
-                    idx = EXPLOSION_NB_FRAMES - 1;
-                float tw, th;
-                SDL_GetTextureSize(tex_explosion, &tw, &th);
-                float fw = tw / EXPLOSION_NB_FRAMES;
-                SDL_FRect src = {idx * fw, 0, fw, th};
-                SDL_RenderTexture(renderer, tex_explosion, &src, &rect);
-            }
-            else
-            {
-                SDL_SetRenderDrawColor(renderer, 255, 128, 0, 255);
-                SDL_RenderFillRect(renderer, &rect);
-            }
+            float p = 1.0f - (e.dx / EXPLOSION_DURATION);
+            int idx = (int)(p * EXPLOSION_NB_FRAMES);
+            if (idx >= EXPLOSION_NB_FRAMES)
+                idx = EXPLOSION_NB_FRAMES - 1;
+            if (idx < 0)
+                idx = 0;
+            batch_sprite(&rect, SPRITE_EXPLOSION + idx, (SDL_Color){255, 128, 0, 255});
         }
     }
 
+    batch_flush();
+    TRACE_END("sprites");
+
     // --- HUD ---
+    TRACE_BEGIN("hud");
     char buffer[64];
     SDL_Color white = {255, 255, 255, 255};
     SDL_Color red = {255, 50, 50, 255};
@@ -558,13 +806,17 @@ static void sdl_render(const GameModel *model)
         draw_text_centered("ESC to Quit", GAME_WIDTH / 2.0f, GAME_HEIGHT / 2.0f + 50, white);
     }
 
+    TRACE_END("hud");
+
     // --- MENUS ---
+    TRACE_BEGIN("menus");
     if (model->menu_mode != 0)
     {
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
         SDL_FRect full = {0, 0, GAME_WIDTH, GAME_HEIGHT};
         SDL_RenderFillRect(renderer, &full);
+        frame_draw_calls++;
 
         float cx = GAME_WIDTH / 2.0f;
         float cy = GAME_HEIGHT / 2.0f;
@@ -636,46 +888,95 @@ static void sdl_render(const GameModel *model)
                 }
             }
             draw_text_centered("ENTER or CLICK to select", cx, items_base_y + 4 * items_spacing + 15, white);
+            draw_text_centered("LEFT / RIGHT to rewind", cx, items_base_y + 4 * items_spacing + 45, (SDL_Color){100, 100, 100, 255});
         }
     }
 
+    if (show_perf)
+        draw_perf_overlay(model);
+    TRACE_END("menus");
+
+    TRACE_BEGIN("present");
+    PERF_BEGIN(PERF_PRESENT);
     SDL_RenderPresent(renderer);
+    PERF_END(PERF_PRESENT);
+    TRACE_END("present");
+
+    PERF_DRAW_CALLS(frame_draw_calls);
+    total_draw_calls += frame_draw_calls;
+    if (frame_draw_calls > max_draw_calls)
+        max_draw_calls = frame_draw_calls;
+    frames_drawn++;
+    frame_draw_calls = 0;
 }
 
-GameView view_sdl_get_interface(void)
+// --- SONS ---
+// Les événements d'une image sont regroupés par type : un seul son par type,
+// joué plus fort quand l'événement s'est répété (10 explosions = 1 son fort).
+
+static int sfx_volume(int count)
 {
-    GameView v;
-    v.init = sdl_init;
-    v.close = sdl_close;
-    v.render = sdl_render;
-    v.get_input = sdl_get_input;
-    return v;
+    int volume = AUDIO_VOLUME_MAX / 2 + (count - 1) * AUDIO_VOLUME_MAX / 8;
+    return volume > AUDIO_VOLUME_MAX ? AUDIO_VOLUME_MAX : volume;
 }
 
-void play_item_sound(void)
-{
 #if HAVE_SDL_MIXER
-    if (sfx_item)
-        Mix_PlayChannel(-1, sfx_item, 0);
-#else
-    play_sound_fallback("assets/alarme6.WAV");
-#endif
-}
-void play_explosion_sound(void)
+static void play_sfx(Mix_Chunk *chunk, int count)
 {
-#if HAVE_SDL_MIXER
-    if (sfx_explosion)
-        Mix_PlayChannel(-1, sfx_explosion, 0);
+    if (!chunk || count <= 0)
+        return;
+    int channel = Mix_PlayChannel(-1, chunk, 0);
+    if (channel >= 0)
+    {
+        Mix_Volume(channel, sfx_volume(count) * MIX_MAX_VOLUME / AUDIO_VOLUME_MAX);
+        SDL_LockMutex(sfx_lock);
+        if (!sfx_trigger_ns)
+            sfx_trigger_ns = SDL_GetTicksNS();
+        SDL_UnlockMutex(sfx_lock);
+    }
+}
 #else
-    play_sound_fallback("assets/explosionaudio.WAV");
+static void play_sfx(int sound, int count)
+{
+    if (count > 0)
+        audio_play(sound, sfx_volume(count));
+}
 #endif
+
+static void sdl_handle_events(const ModelEvent *events, int count)
+{
+    int shots = 0, explosions = 0, pickups = 0;
+    for (int i = 0; i < count; i++)
+    {
+        switch (events[i].type)
+        {
+        case MODEL_EVENT_SHOT:
+            if (events[i].arg == ENTITY_BULLET_PLAYER)
+                shots++;
+            break;
+        case MODEL_EVENT_EXPLOSION:
+            explosions++;
+            break;
+        case MODEL_EVENT_PICKUP:
+            pickups++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    play_sfx(sfx_shoot, shots);
+    play_sfx(sfx_explosion, explosions);
+    play_sfx(sfx_item, pickups);
 }
-void play_shoot_sound(void)
+
+GameView view_sdl_get_interface(void)
 {
-#if HAVE_SDL_MIXER
-    if (sfx_shoot)
-        Mix_PlayChannel(-1, sfx_shoot, 0);
-#else
-    play_sound_fallback("assets/tielaser.WAV");
-#endif
-}
\ No newline at end of file
+    GameView v;
+    v.init = sdl_init;
+    v.close = sdl_close;
+    v.render = sdl_render;
+    v.get_input = sdl_get_input;
+    v.handle_events = sdl_handle_events;
+    return v;
+}